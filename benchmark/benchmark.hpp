@@ -0,0 +1,68 @@
+#pragma once
+
+#if defined(_MSC_VER) and not defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace benchmark {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Runs the given function the given number of times and returns the average number of nanoseconds that each run took.
+/// </summary>
+template < typename Fn_T >
+double time_ns(size_t repetitions, Fn_T&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (auto i = size_t{0}; i < repetitions; ++i) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration< double, std::nano >(end - start).count() / static_cast< double >(repetitions);
+}
+
+/// <summary>
+/// Stops the compiler from optimising away a result that is otherwise unused. The value's address escapes into an
+/// empty block of assembly that the compiler has to assume reads (and writes) any memory, so everything the value
+/// refers to has to have been computed and stored by the time keep is called.
+/// </summary>
+template < typename T >
+void keep(const T& value) {
+#if defined(_MSC_VER) and not defined(__clang__)
+  // No inline assembly on x64 MSVC: pass the address through a volatile, and fence the compiler's reordering.
+  const auto address = reinterpret_cast< const volatile char* >(&value);
+  static_cast< void >(*address);
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+inline void print_header(std::string_view title) { std::cout << "\n" << title << "\n" << std::string(title.size(), '-') << "\n"; }
+
+///////////////////////////////////////////////////////////////////////////////
+
+void find_many();
+void collection_builder();
+void sort_by_id();
+void join();
+void fixed_string();
+void parallel_for();
+void compaction();
+void collection_view();
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace benchmark
+
+///////////////////////////////////////////////////////////////////////////////
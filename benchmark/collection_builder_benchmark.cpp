@@ -0,0 +1,83 @@
+#include "benchmark.hpp"
+
+#include <typed/collection_builder.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Sprocket : public typed::identifiable< Sprocket, size_t > {
+ public:
+  Sprocket(size_t id) : typed::identifiable< Sprocket, size_t >{id} {}
+};
+
+using Sprockets = typed::identifiable_item_collection< Sprocket, size_t >;
+
+template < typename Fn_T >
+void run_threads(size_t thread_count, Fn_T&& fn) {
+  auto threads = std::vector< std::jthread >{};
+  for (auto t = size_t{0}; t < thread_count; ++t) {
+    threads.emplace_back(fn, t);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::collection_builder() {
+  print_header("Mutex-guarded add vs. collection_builder: total build time");
+
+  constexpr auto item_count = size_t{16'384};
+
+  auto rng = std::mt19937_64{42};
+  auto ids = std::vector< size_t >(item_count);
+  for (auto&& id : ids) {
+    id = rng() % (item_count * 4);
+  }
+
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "mutex (ms)" << std::setw(16) << "builder (ms)" << std::setw(10)
+            << "speedup" << "\n";
+
+  for (auto thread_count = size_t{1}; thread_count <= 64; thread_count *= 2) {
+    const auto per_thread = item_count / thread_count;
+
+    const auto guarded = time_ns(1, [&] {
+      auto sprockets = Sprockets{};
+      auto mutex     = std::mutex{};
+      run_threads(thread_count, [&](size_t t) {
+        for (auto i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+          auto lock = std::lock_guard{mutex};
+          sprockets.add(Sprocket{ids[i]});
+        }
+      });
+      keep(sprockets);
+    });
+
+    const auto built = time_ns(1, [&] {
+      auto builder = typed::collection_builder< Sprockets >{thread_count};
+      run_threads(thread_count, [&](size_t t) {
+        for (auto i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+          builder.partial(t).add(Sprocket{ids[i]});
+        }
+      });
+
+      auto sprockets = builder.build(thread_count);
+      keep(sprockets);
+    });
+
+    std::cout << std::setw(8) << thread_count << std::setw(16) << std::fixed << std::setprecision(2) << guarded / 1e6
+              << std::setw(16) << built / 1e6 << std::setw(9) << guarded / built << "x\n";
+  }
+}
@@ -0,0 +1,117 @@
+#include "benchmark.hpp"
+#include "collection_view_plugin.hpp"
+
+#include <typed/collection_view.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/index_range.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Goose
+    : public typed::identifiable< Goose, size_t >
+    , public plugin::Weighed {
+ public:
+  Goose(size_t id, double weight) : typed::identifiable< Goose, size_t >{id}, _weight{weight} {}
+
+  [[nodiscard]] double weight() const noexcept override { return _weight; }
+
+ private:
+  double _weight;
+};
+
+using Geese = typed::identifiable_item_collection< Goose >;
+
+class PerItemGeeseView final : public plugin::PerItemView {
+ public:
+  explicit PerItemGeeseView(const Geese& geese) : _geese{&geese} {}
+
+  [[nodiscard]] size_t size() const noexcept override { return _geese->size().get(); }
+  [[nodiscard]] const plugin::Weighed* find(size_t id) const override { return _geese->find(Goose::id_type{id}); }
+  [[nodiscard]] const plugin::Weighed* at(size_t position) const override { return &_geese->at(Geese::index_type{position}); }
+
+ private:
+  const Geese* _geese;
+};
+
+template < typename Fn_T >
+double time_ms(size_t repetitions, Fn_T&& fn) {
+  auto totals = std::vector< double >(1);
+  const auto ns = benchmark::time_ns(repetitions, [&] {
+    totals[0] += fn();
+    benchmark::keep(totals);
+  });
+
+  return ns / 1e6;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::collection_view() {
+  print_header("Type-erased access: templates vs. batched view vs. a virtual call per item");
+
+  std::cout << std::setw(8) << "items" << std::setw(36) << "find: direct / batched / per item" << std::setw(36)
+            << "scan: direct / batched / per item" << "  (ms)\n";
+
+  auto rng = std::mt19937{11};
+  for (auto item_count = size_t{4'096}; item_count <= 1'048'576; item_count *= 16) {
+    auto geese = Geese{};
+    geese.build_index();
+    for (auto i = size_t{0}; i < item_count; ++i) {
+      geese.add(Goose{i, static_cast< double >(i % 13)});
+    }
+
+    auto ids = std::vector< size_t >(item_count);
+    std::iota(ids.begin(), ids.end(), size_t{0});
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    const auto batched  = typed::make_collection_view< plugin::Weighed >(geese);
+    const auto per_item = PerItemGeeseView{geese};
+
+    // Enough runs of the small collections for the timer to resolve them.
+    const auto runs = std::max< size_t >(5, (size_t{1} << 22) / item_count);
+
+    const auto find_direct = time_ms(runs, [&] {
+      auto typed_ids = std::vector< Goose::id_type >(ids.begin(), ids.end());
+      auto found     = std::vector< const Goose* >(ids.size());
+      geese.find_many(typed_ids, found);
+
+      auto total = 0.0;
+      for (auto&& goose : found) {
+        total += goose->weight();
+      }
+
+      return total;
+    });
+    const auto find_view = time_ms(runs, [&] { return plugin::find_batched(batched, ids); });
+    const auto find_each = time_ms(runs, [&] { return plugin::find_per_item(per_item, ids); });
+
+    const auto scan_direct = time_ms(runs, [&] {
+      auto total = 0.0;
+      for (auto idx : typed::indices(geese)) {
+        total += geese.at(idx).weight();
+      }
+
+      return total;
+    });
+    const auto scan_view = time_ms(runs, [&] { return plugin::scan_batched(batched); });
+    const auto scan_each = time_ms(runs, [&] { return plugin::scan_per_item(per_item); });
+
+    std::cout << std::setw(8) << item_count << std::fixed << std::setprecision(3) << std::setw(12) << find_direct
+              << std::setw(12) << find_view << std::setw(12) << find_each << std::setw(12) << scan_direct << std::setw(12)
+              << scan_view << std::setw(12) << scan_each << "\n";
+  }
+}
@@ -0,0 +1,49 @@
+#include "collection_view_plugin.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+
+double plugin::find_per_item(const PerItemView& view, const std::vector< size_t >& ids) {
+  auto total = 0.0;
+  for (auto id : ids) {
+    total += view.find(id)->weight();
+  }
+
+  return total;
+}
+
+double plugin::find_batched(const WeighedView& view, const std::vector< size_t >& ids) {
+  auto found = std::vector< const Weighed* >(ids.size());
+  view.find_many(ids, found);
+
+  auto total = 0.0;
+  for (auto&& item : found) {
+    total += item->weight();
+  }
+
+  return total;
+}
+
+double plugin::scan_per_item(const PerItemView& view) {
+  auto total = 0.0;
+  for (auto i = size_t{0}; i < view.size(); ++i) {
+    total += view.at(i)->weight();
+  }
+
+  return total;
+}
+
+double plugin::scan_batched(const WeighedView& view) {
+  // Each chunk is summed into a local: the compiler can't tell that an item's weight isn't total itself, so adding to
+  // total directly would store it and load it back for every item.
+  auto total = 0.0;
+  view.for_each_chunk([&total](auto chunk) {
+    auto sum = 0.0;
+    for (auto&& item : chunk) {
+      sum += item->weight();
+    }
+
+    total += sum;
+  });
+
+  return total;
+}
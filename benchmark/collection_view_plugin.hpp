@@ -0,0 +1,41 @@
+#pragma once
+
+#include <typed/collection_view.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The side of the collection_view benchmark that only knows the interfaces, as a plugin would. It's compiled on its own,
+// so that the compiler can't see which classes implement them and turn the virtual calls into direct ones.
+namespace plugin {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Weighed {
+  virtual ~Weighed() = default;
+  [[nodiscard]] virtual double weight() const noexcept = 0;
+};
+
+using WeighedView = typed::identifiable_collection_view< Weighed, size_t >;
+
+// The obvious interface, with a virtual call for every item, for comparison.
+struct PerItemView {
+  virtual ~PerItemView() = default;
+  [[nodiscard]] virtual size_t size() const noexcept = 0;
+  [[nodiscard]] virtual const Weighed* find(size_t id) const = 0;
+  [[nodiscard]] virtual const Weighed* at(size_t position) const = 0;
+};
+
+double find_per_item(const PerItemView& view, const std::vector< size_t >& ids);
+double find_batched(const WeighedView& view, const std::vector< size_t >& ids);
+
+double scan_per_item(const PerItemView& view);
+double scan_batched(const WeighedView& view);
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace plugin
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,118 @@
+#include "benchmark.hpp"
+
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/index_range.hpp>
+#include <typed/ordering.hpp>
+#include <typed/secondary_index.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Puffin : public typed::identifiable< Puffin, size_t > {
+ public:
+  Puffin(size_t id, double weight) : typed::identifiable< Puffin, size_t >{id}, weight{weight} {}
+
+  [[nodiscard]] int colony() const noexcept { return static_cast< int >(id().get() % 10); }
+
+  double weight;
+};
+
+struct by_colony {};
+
+using Puffins = typed::identifiable_item_collection< Puffin >;
+
+// Only ten keys, so each has a lot of items.
+using PuffinsByColony = typed::identifiable_item_collection< Puffin,
+                                                             size_t,
+                                                             typed::ordered_non_unique< by_colony, &Puffin::colony > >;
+
+// Adds the puffins in a random order, with other allocations in between, and then sorts them: the way a long-lived
+// collection ends up after a lot of adding and removing.
+template < typename Collection_T = Puffins >
+Collection_T make_scattered_puffins(size_t count, std::mt19937& rng) {
+  auto ids = std::vector< size_t >(count);
+  std::iota(ids.begin(), ids.end(), size_t{0});
+  std::shuffle(ids.begin(), ids.end(), rng);
+
+  auto out = Collection_T{};
+  out.build_index();
+  auto clutter = std::vector< std::unique_ptr< char[] > >{};
+  for (auto id : ids) {
+    out.add(Puffin{id, static_cast< double >(id % 100)});
+    clutter.push_back(std::make_unique< char[] >(rng() % 256 + 1));
+  }
+
+  typed::sort_by_id(out);
+  return out;
+}
+
+template < typename Collection_T >
+double time_scan(const Collection_T& puffins) {
+  auto total = std::vector< double >(1);
+  return benchmark::time_ns(10, [&] {
+    for (auto idx : typed::indices(puffins)) {
+      total[0] += puffins.at(idx).weight;
+    }
+    benchmark::keep(total);
+  });
+}
+
+template < typename Collection_T >
+void compact_scattered_puffins() {
+  std::cout << std::setw(8) << "items" << std::setw(14) << "frag before" << std::setw(20) << "scan before / after"
+            << std::setw(12) << "compact" << std::setw(16) << "longest slice" << std::setw(16) << "shrink_to_fit"
+            << "  (ms)\n";
+
+  constexpr auto slice = std::chrono::microseconds{200};
+
+  auto rng = std::mt19937{9};
+  for (auto item_count = size_t{16'384}; item_count <= 1'048'576; item_count *= 8) {
+    auto puffins      = make_scattered_puffins< Collection_T >(item_count, rng);
+    const auto before = puffins.memory_usage();
+    const auto scan_before = time_scan(puffins);
+
+    auto slices          = size_t{0};
+    auto longest_slice   = 0.0;
+    const auto compacted = benchmark::time_ns(1, [&] {
+      auto done = false;
+      while (not done) {
+        longest_slice = std::max(longest_slice, benchmark::time_ns(1, [&] { done = puffins.compact(slice); }));
+        ++slices;
+      }
+    });
+
+    const auto shrunk     = benchmark::time_ns(1, [&] { puffins.shrink_to_fit(); });
+    const auto scan_after = time_scan(puffins);
+
+    std::cout << std::setw(8) << item_count << std::fixed << std::setprecision(3) << std::setw(14)
+              << before.fragmentation << std::setw(10) << scan_before / 1e6 << std::setw(10) << scan_after / 1e6
+              << std::setw(12) << compacted / 1e6 << std::setw(16) << longest_slice / 1e6 << std::setw(16) << shrunk / 1e6
+              << "  (" << slices << " slices, memory_usage " << before.total() / 1024 << " -> "
+              << puffins.memory_usage().total() / 1024 << " KiB)\n";
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::compaction() {
+  print_header("Scanning a collection before and after compact()");
+  compact_scattered_puffins< Puffins >();
+
+  print_header("compact() with a non-unique secondary index over ten keys");
+  compact_scattered_puffins< PuffinsByColony >();
+}
@@ -0,0 +1,106 @@
+#include "benchmark.hpp"
+
+#include <typed/collection_builder.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Widget : public typed::identifiable< Widget, size_t > {
+ public:
+  Widget(size_t id) : typed::identifiable< Widget, size_t >{id} {}
+};
+
+using Widgets = typed::identifiable_item_collection< Widget, size_t >;
+
+// Filled through a builder, a slice of the items per partial, so that a big collection doesn't take long to make.
+Widgets make_widgets(size_t item_count, std::mt19937_64& rng, std::vector< Widget::id_type >& ids) {
+  constexpr auto partial_count = size_t{64};
+
+  auto builder = typed::collection_builder< Widgets >{partial_count};
+  for (auto i = size_t{0}; i < item_count; ++i) {
+    ids.push_back(builder.partial(i % partial_count).add(Widget{rng()}).first->id());
+  }
+
+  return builder.build();
+}
+
+struct timings_type {
+  double find;
+  double find_many;
+};
+
+// Const lookups don't build the index, so they show the cost of scanning when there isn't one.
+timings_type time_lookups(const Widgets& widgets,
+                          const std::vector< Widget::id_type >& ids,
+                          size_t batch_size,
+                          std::mt19937_64& rng) {
+  auto batch = std::vector< Widget::id_type >{};
+  std::sample(ids.begin(), ids.end(), std::back_inserter(batch), batch_size, rng);
+  std::shuffle(batch.begin(), batch.end(), rng);
+
+  auto found = std::vector< const Widget* >(batch.size());
+
+  const auto repetitions = std::max< size_t >(1, 16'384 / batch_size);
+
+  const auto one_at_a_time = benchmark::time_ns(repetitions, [&] {
+    std::transform(batch.begin(), batch.end(), found.begin(), [&](auto&& id) { return widgets.find(id); });
+    benchmark::keep(found);
+  });
+
+  const auto batched = benchmark::time_ns(repetitions, [&] {
+    widgets.find_many(batch, found);
+    benchmark::keep(found);
+  });
+
+  return {one_at_a_time / batch_size, batched / batch_size};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::find_many() {
+  print_header("find vs. find_many: latency per ID");
+
+  auto rng = std::mt19937_64{42};
+
+  // The index is searched in the biggest collection, which is several times the size of a typical last-level cache, so
+  // that most probes of the index miss the cache; scanning is only timed in the small one.
+  for (auto item_count : {size_t{20'000}, size_t{8'000'000}}) {
+    auto ids           = std::vector< Widget::id_type >{};
+    auto widgets       = make_widgets(item_count, rng, ids);
+    const auto scanned = item_count <= 20'000;
+
+    std::cout << "\n"
+              << item_count << " items\n"
+              << std::setw(8) << "batch" << std::setw(30) << (scanned ? "no index: find / find_many" : "") << std::setw(30)
+              << "index: find / find_many" << "  (ns/id)\n";
+
+    for (auto batch_size = size_t{16}; batch_size <= 4096; batch_size *= 4) {
+      std::cout << std::setw(8) << batch_size << std::fixed << std::setprecision(1);
+
+      widgets.drop_index();
+      if (scanned) {
+        const auto scan = time_lookups(widgets, ids, batch_size, rng);
+        std::cout << std::setw(15) << scan.find << std::setw(15) << scan.find_many;
+      } else {
+        std::cout << std::setw(30) << "";
+      }
+
+      widgets.build_index();
+      const auto indexed = time_lookups(widgets, ids, batch_size, rng);
+      std::cout << std::setw(15) << indexed.find << std::setw(15) << indexed.find_many << "\n";
+    }
+  }
+}
@@ -0,0 +1,86 @@
+#include "benchmark.hpp"
+
+#include <typed/fixed_string.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/ordering.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+template < typename Name_T >
+class Kitten : public typed::identifiable< Kitten< Name_T >, Name_T > {
+ public:
+  explicit Kitten(Name_T id) : typed::identifiable< Kitten< Name_T >, Name_T >{std::move(id)} {}
+};
+
+template < typename Name_T >
+using Kittens = typed::identifiable_item_collection< Kitten< Name_T >, size_t >;
+
+template < typename Name_T >
+Kittens< Name_T > make_kittens(const std::vector< std::string >& names) {
+  auto out = Kittens< Name_T >{};
+  out.build_index();
+  for (auto&& name : names) {
+    out.add(Kitten< Name_T >{Name_T{name}});
+  }
+
+  return out;
+}
+
+template < typename Name_T >
+double time_lookups(const Kittens< Name_T >& kittens, const std::vector< std::string >& names) {
+  auto ids = std::vector< typename Kitten< Name_T >::id_type >{};
+  for (auto&& name : names) {
+    ids.emplace_back(Name_T{name});
+  }
+
+  auto found = std::vector< const Kitten< Name_T >* >(ids.size());
+  return benchmark::time_ns(1, [&] {
+    kittens.find_many(ids, found);
+    benchmark::keep(found);
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::fixed_string() {
+  print_header("String IDs: std::string vs. fixed_string< 24 >");
+
+  std::cout << std::setw(8) << "items" << std::setw(28) << "sort_by_id: string / fixed" << std::setw(28)
+            << "find_many: string / fixed" << "  (ms)\n";
+
+  auto rng = std::mt19937{5};
+  for (auto item_count = size_t{4'096}; item_count <= 262'144; item_count *= 8) {
+    auto names = std::vector< std::string >{};
+    for (auto i = size_t{0}; i < item_count; ++i) {
+      names.push_back("Cat-2022-04-27-" + std::to_string(rng() % 100'000'000));
+    }
+
+    auto strings = make_kittens< std::string >(names);
+    auto fixed   = make_kittens< typed::fixed_string< 24 > >(names);
+
+    std::shuffle(names.begin(), names.end(), rng);
+    const auto string_lookup = time_lookups(strings, names);
+    const auto fixed_lookup  = time_lookups(fixed, names);
+
+    const auto string_sort = time_ns(1, [&] { typed::sort_by_id(strings); });
+    const auto fixed_sort  = time_ns(1, [&] { typed::sort_by_id(fixed); });
+
+    std::cout << std::setw(8) << item_count << std::fixed << std::setprecision(3) << std::setw(14) << string_sort / 1e6
+              << std::setw(14) << fixed_sort / 1e6 << std::setw(14) << string_lookup / 1e6 << std::setw(14)
+              << fixed_lookup / 1e6 << "\n";
+  }
+}
@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/join.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Part : public typed::identifiable< Part, uint32_t > {
+ public:
+  explicit Part(uint32_t id) : typed::identifiable< Part, uint32_t >{id} {}
+};
+
+using Parts = typed::identifiable_item_collection< Part, size_t >;
+
+class Order : public typed::identifiable< Order, size_t > {
+ public:
+  Order(size_t id, Part::id_type part) : typed::identifiable< Order, size_t >{id}, part{part} {}
+
+  Part::id_type part;
+};
+
+using Orders = typed::identifiable_item_collection< Order, size_t >;
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::join() {
+  print_header("find per reference vs. join: resolving every order's part");
+
+  std::cout << std::setw(8) << "parts" << std::setw(8) << "orders" << std::setw(12) << "find (ms)" << std::setw(12)
+            << "hash (ms)" << std::setw(16) << "sort-merge (ms)" << "\n";
+
+  auto rng = std::mt19937{42};
+  for (auto part_count = uint32_t{1'024}; part_count <= 262'144; part_count *= 16) {
+    // Index both collections before filling them, so that checking each new item's ID doesn't scan.
+    auto parts = Parts{};
+    parts.build_index();
+    for (auto i = uint32_t{0}; i < part_count; ++i) {
+      parts.add(Part{i * 7});
+    }
+    parts.build_index();
+
+    auto orders = Orders{};
+    orders.build_index();
+    for (auto i = size_t{0}; i < 4 * part_count; ++i) {
+      orders.add(Order{i, Part::id_type{static_cast< uint32_t >(rng() % (8 * part_count))}});
+    }
+
+    const auto& const_parts = parts;
+    auto resolved           = std::vector< const Part* >(orders.size().get());
+    const auto found        = time_ns(1, [&] {
+      for (auto i = Orders::index_type{0}; i < orders.size(); ++i) {
+        resolved[i.get()] = const_parts.find(orders.at(i).part);
+      }
+      keep(resolved);
+    });
+
+    const auto hashed = time_ns(1, [&] { keep(typed::join(orders, &Order::part, parts, typed::join_strategy::hash)); });
+    const auto merged = time_ns(1, [&] { keep(typed::join(orders, &Order::part, parts, typed::join_strategy::sort_merge)); });
+
+    std::cout << std::setw(8) << part_count << std::setw(8) << 4 * part_count << std::fixed << std::setprecision(3)
+              << std::setw(12) << found / 1e6 << std::setw(12) << hashed / 1e6 << std::setw(16) << merged / 1e6 << "\n";
+  }
+}
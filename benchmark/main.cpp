@@ -0,0 +1,34 @@
+// main.cpp : Runs the benchmarks. Pass the names of the benchmarks to run on the command line, or nothing to run all of them.
+//
+
+#include "benchmark.hpp"
+
+#include <functional>
+#include <string_view>
+#include <utility>
+
+int main(int argc, char* argv[]) {
+  const std::pair< std::string_view, std::function< void() > > benchmarks[] = {
+      {"find_many", benchmark::find_many},
+      {"collection_builder", benchmark::collection_builder},
+      {"sort_by_id", benchmark::sort_by_id},
+      {"join", benchmark::join},
+      {"fixed_string", benchmark::fixed_string},
+      {"parallel_for", benchmark::parallel_for},
+      {"compaction", benchmark::compaction},
+      {"collection_view", benchmark::collection_view},
+  };
+
+  for (auto&& [name, run] : benchmarks) {
+    auto selected = argc < 2;
+    for (auto i = 1; i < argc; ++i) {
+      selected = selected or name == argv[i];
+    }
+
+    if (selected) {
+      run();
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/index_range.hpp>
+#include <typed/parallel.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Sensor : public typed::identifiable< Sensor, size_t > {
+ public:
+  explicit Sensor(size_t id) : typed::identifiable< Sensor, size_t >{id} {}
+
+  uint64_t reading{0};
+};
+
+using Sensors = typed::identifiable_item_collection< Sensor, size_t >;
+
+// A few hundred nanoseconds of arithmetic per item, with the cost varying from item to item, so that an even split of
+// the range wouldn't be an even split of the work.
+void calibrate(Sensor& sensor) {
+  auto x = static_cast< uint64_t >(sensor.id().get());
+  for (auto round = uint64_t{0}; round < 32 + (x % 7) * 32; ++round) {
+    x = (x ^ (x >> 31)) * 0x9e3779b97f4a7c15ull + round;
+  }
+
+  sensor.reading = x;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::parallel_for() {
+  print_header("Serial loops vs. parallel_for and parallel_reduce over 2M items");
+
+  auto sensors = Sensors{};
+  sensors.build_index();
+  for (auto i = size_t{0}; i < 2'000'000; ++i) {
+    sensors.add(Sensor{i});
+  }
+
+  const auto reading_of = [](const Sensor& sensor) { return sensor.reading; };
+
+  const auto serial_for = time_ns(1, [&] {
+    for (auto i = Sensors::index_type{0}; i < sensors.size(); ++i) {
+      calibrate(sensors.at(i));
+    }
+  });
+
+  auto total               = uint64_t{0};
+  const auto serial_reduce = time_ns(5, [&] {
+    for (auto i = Sensors::index_type{0}; i < sensors.size(); ++i) {
+      total += reading_of(sensors.at(i));
+    }
+    keep(total);
+  });
+
+  std::cout << std::setw(8) << "threads" << std::setw(14) << "for (ms)" << std::setw(10) << "speedup" << std::setw(14)
+            << "reduce (ms)" << std::setw(10) << "speedup" << "\n";
+  std::cout << std::setw(8) << "serial" << std::fixed << std::setprecision(2) << std::setw(14) << serial_for / 1e6
+            << std::setw(10) << "" << std::setw(14) << serial_reduce / 1e6 << "\n";
+
+  const auto max_threads = std::max< size_t >(std::thread::hardware_concurrency(), 1);
+  for (auto threads = size_t{1}; threads <= max_threads; threads *= 2) {
+    auto pool = typed::parallel_pool{threads - 1};
+
+    const auto parallel_for = time_ns(1, [&] { typed::parallel_for(pool, sensors, calibrate); });
+
+    const auto parallel_reduce = time_ns(5, [&] {
+      total += typed::parallel_reduce(pool, sensors, uint64_t{0}, reading_of, std::plus<>{});
+      keep(total);
+    });
+
+    std::cout << std::setw(8) << threads << std::setw(14) << parallel_for / 1e6 << std::setw(9) << std::setprecision(1)
+              << serial_for / parallel_for << "x" << std::setprecision(2) << std::setw(14) << parallel_reduce / 1e6
+              << std::setw(9) << std::setprecision(1) << serial_reduce / parallel_reduce << "x\n"
+              << std::setprecision(2);
+  }
+}
@@ -0,0 +1,92 @@
+#include "benchmark.hpp"
+
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/key_traits.hpp>
+#include <typed/ordering.hpp>
+
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Two identical composite serial numbers, one of which declares a packing and one of which doesn't.
+struct PackedSerial {
+  uint8_t region;
+  uint8_t version;
+  uint16_t facility;
+
+  auto operator<=>(const PackedSerial&) const = default;
+};
+
+struct PlainSerial {
+  uint8_t region;
+  uint8_t version;
+  uint16_t facility;
+
+  auto operator<=>(const PlainSerial&) const = default;
+};
+
+}  // namespace
+
+template <>
+struct typed::key_traits< PackedSerial > {
+  using key_type = uint32_t;
+
+  static constexpr key_type pack(const PackedSerial& sn) noexcept {
+    return (static_cast< key_type >(sn.region) << 24) | (static_cast< key_type >(sn.version) << 16) | sn.facility;
+  }
+};
+
+namespace {
+
+template < typename Serial_T >
+class Gadget : public typed::identifiable< Gadget< Serial_T >, Serial_T > {
+ public:
+  Gadget(Serial_T id) : typed::identifiable< Gadget< Serial_T >, Serial_T >{id} {}
+};
+
+template < typename Serial_T >
+using Gadgets = typed::identifiable_item_collection< Gadget< Serial_T >, size_t >;
+
+template < typename Serial_T >
+Gadgets< Serial_T > make_gadgets(size_t count) {
+  auto out = Gadgets< Serial_T >{};
+  for (auto i = size_t{0}; i < count; ++i) {
+    // Every value is distinct, so that no time is spent rejecting duplicates.
+    const auto value = static_cast< uint32_t >(i * 2654435761u);
+    out.add(Gadget< Serial_T >{Serial_T{static_cast< uint8_t >(value >> 24),
+                                        static_cast< uint8_t >(value >> 16),
+                                        static_cast< uint16_t >(value)}});
+  }
+
+  return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchmark::sort_by_id() {
+  print_header("sort_by_id with composite IDs: packed (radix) vs. field-by-field comparison");
+
+  std::cout << std::setw(8) << "items" << std::setw(16) << "compare (ms)" << std::setw(16) << "packed (ms)" << std::setw(10)
+            << "speedup" << "\n";
+
+  for (auto item_count = size_t{1'024}; item_count <= 16'384; item_count *= 4) {
+    auto plain  = make_gadgets< PlainSerial >(item_count);
+    auto packed = make_gadgets< PackedSerial >(item_count);
+
+    const auto compared = time_ns(1, [&] { typed::sort_by_id(plain); });
+    const auto radixed  = time_ns(1, [&] { typed::sort_by_id(packed); });
+
+    std::cout << std::setw(8) << item_count << std::setw(16) << std::fixed << std::setprecision(3) << compared / 1e6
+              << std::setw(16) << radixed / 1e6 << std::setw(9) << std::setprecision(1) << compared / radixed << "x\n";
+  }
+}
@@ -5,7 +5,12 @@
 #include <typed/identifiable_item_collection.hpp>
 #include <typed/io/idio.hpp>
 #include <typed/io/indexio.hpp>
+#include <typed/key_traits.hpp>
+#include <typed/ordering.hpp>
+#include <typed/parallel.hpp>
+#include <typed/secondary_index.hpp>
 
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -64,12 +69,33 @@ struct SerialNumber {
   }
 };
 
+/// <summary>
+/// Serial numbers compare field-by-field, but they also fit in a single 32-bit number that sorts in the same order. Saying
+/// so here means that collections of things with serial numbers for IDs can sort and search on that number instead.
+/// </summary>
+template <>
+struct typed::key_traits< SerialNumber > {
+  using key_type = uint32_t;
+
+  static constexpr key_type pack(const SerialNumber& sn) noexcept {
+    return (static_cast< key_type >(sn.region) << 24) | (static_cast< key_type >(sn.version) << 16) | sn.facility;
+  }
+};
+
 class Printer : public typed::identifiable<Printer, SerialNumber> {
  public:
   Printer(SerialNumber id) : typed::identifiable< Printer, SerialNumber >{id} {}
+
+  uint16_t facility() const noexcept { return id().get().facility; }
 };
 
-using Printers = typed::identifiable_item_collection<Printer, size_t>;
+/// <summary>
+/// Collections can also have secondary indexes, for finding things by something other than their ID. This one lets you
+/// find all the printers from a facility without looking at every printer.
+/// </summary>
+struct by_facility {};
+
+using Printers = typed::identifiable_item_collection< Printer, size_t, typed::ordered_non_unique< by_facility, &Printer::facility > >;
 
 int main() {
   /////////////////////////////////////////////////////////////////////////////
@@ -115,6 +141,12 @@ int main() {
   //   std::cout << "Dog " << i << " has ID " << ducks.at(i).id() << std::endl;
   // }
 
+  // Big collections can be worked through in parallel. The range of indices is still typed, so the same goes for
+  // using it on the wrong collection.
+  const auto id_total = typed::parallel_reduce(
+      typed::indices(dogs), size_t{0}, [&](Dogs::index_type i) { return dogs.at(i).id().get(); }, std::plus<>{});
+  std::cout << "The dog IDs add up to " << id_total << std::endl;
+
   /////////////////////////////////////////////////////////////////////////////
   //
   // Cats
@@ -151,5 +183,13 @@ int main() {
   const auto p1 = printers.find(Printer::id_type{{10, 02, 2555}});
   std::cout << "Found printer with serial number " << p1->id() << std::endl;
 
+  for (auto&& printer : printers.by< by_facility >().equal_range(2553)) {
+    std::cout << "Printer " << printer.id() << " came from facility 2553" << std::endl;
+  }
+
+  printers.add(Printer{{9, 01, 1000}});
+  typed::sort_by_id(printers);
+  std::cout << "The printer with the lowest serial number is " << printers.at(Printers::index_type{0}).id() << std::endl;
+
   return 0;
 }
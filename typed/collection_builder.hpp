@@ -0,0 +1,180 @@
+#pragma once
+
+#include <typed/detail/collection_access.hpp>
+#include <typed/detail/run_in_parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Builds one big collection from several partial collections that are filled independently, typically one per
+/// producer thread. Each partial is only ever touched by one thread, so filling them needs no locking. The build step
+/// then combines the partials in parallel.
+///
+/// The result is deterministic: items come out in partial order (all of partial 0, then all of partial 1, and so on),
+/// and where the same ID appears in more than one partial, the item in the lowest-numbered partial wins. That's the same
+/// collection you'd get from adding the items of each partial, in turn, to a single collection.
+/// </summary>
+template < typename Collection_T >
+class collection_builder {
+ public:
+  using collection_type = Collection_T;
+  using value_type      = typename collection_type::value_type;
+  using id_type         = typename collection_type::id_type;
+
+  explicit collection_builder(size_t partial_count) : _partials(std::max< size_t >(partial_count, 1)) {
+    _index_partials();
+  }
+
+  [[nodiscard]] size_t partial_count() const noexcept { return _partials.size(); }
+
+  [[nodiscard]] collection_type& partial(size_t i) { return _partials[i]; }
+  [[nodiscard]] const collection_type& partial(size_t i) const { return _partials[i]; }
+
+  /// <summary>
+  /// Combines all the partials into a single collection, using up to thread_count threads. The partials are left empty,
+  /// so the builder can be filled up and built again.
+  /// </summary>
+  [[nodiscard]] collection_type build(size_t thread_count = std::thread::hardware_concurrency()) {
+    thread_count = std::max< size_t >(thread_count, 1);
+
+    const auto partial_count = _partials.size();
+
+    auto values = std::vector< _container_type >(partial_count);
+    detail::run_in_parallel(thread_count, partial_count, [&](auto p) {
+      values[p] = detail::collection_access::release(_partials[p]);
+    });
+
+    auto keep = _find_first_occurrences(values, thread_count);
+
+    auto offsets = std::vector< size_t >(partial_count + 1, 0);
+    for (auto p = size_t{0}; p < partial_count; ++p) {
+      offsets[p + 1] = offsets[p] + static_cast< size_t >(std::count(keep[p].begin(), keep[p].end(), char{1}));
+    }
+
+    auto out = _container_type(offsets.back());
+    detail::run_in_parallel(thread_count, partial_count, [&](auto p) {
+      auto dest = std::next(out.begin(), offsets[p]);
+      for (auto i = size_t{0}; i < values[p].size(); ++i) {
+        if (keep[p][i]) {
+          *dest++ = std::move(values[p][i]);
+        }
+      }
+    });
+
+    _index_partials();
+
+    return detail::collection_access::adopt< collection_type >(std::move(out));
+  }
+
+ private:
+  // The partials are indexed from the start, so that adding to them checks for duplicates with a search, not a scan.
+  void _index_partials() {
+    for (auto&& partial : _partials) {
+      partial.build_index();
+    }
+  }
+
+  using _container_type = detail::collection_access::container_t< collection_type >;
+
+  struct _key {
+    const id_type* id;
+    size_t partial;
+    size_t position;
+  };
+
+  // Work out which items to keep: an item is dropped if an item with the same ID is in an earlier partial. The IDs of
+  // each partial are sorted, then the ID space is cut into ranges that can be de-duplicated independently.
+  static std::vector< std::vector< char > > _find_first_occurrences(const std::vector< _container_type >& values,
+                                                                    size_t thread_count) {
+    const auto partial_count = values.size();
+
+    auto keep = std::vector< std::vector< char > >(partial_count);
+    for (auto p = size_t{0}; p < partial_count; ++p) {
+      keep[p].assign(values[p].size(), char{1});
+    }
+
+    if (partial_count < 2) {
+      return keep;
+    }
+
+    auto keys = std::vector< std::vector< _key > >(partial_count);
+    detail::run_in_parallel(thread_count, partial_count, [&](auto p) {
+      keys[p].reserve(values[p].size());
+      for (auto i = size_t{0}; i < values[p].size(); ++i) {
+        keys[p].push_back({&values[p][i]->id(), p, i});
+      }
+
+      std::sort(keys[p].begin(), keys[p].end(), [](auto&& lhs, auto&& rhs) { return *lhs.id < *rhs.id; });
+    });
+
+    const auto splitters = _choose_splitters(keys, thread_count * _ranges_per_thread);
+    const auto by_id     = [](const _key& key, const id_type& id) { return *key.id < id; };
+
+    detail::run_in_parallel(thread_count, splitters.size() + 1, [&](auto r) {
+      auto range = std::vector< _key >{};
+      for (auto&& partial_keys : keys) {
+        const auto first = 0 == r ? partial_keys.begin()
+                                  : std::lower_bound(partial_keys.begin(), partial_keys.end(), *splitters[r - 1], by_id);
+        const auto last  = splitters.size() == r
+                               ? partial_keys.end()
+                               : std::lower_bound(partial_keys.begin(), partial_keys.end(), *splitters[r], by_id);
+        range.insert(range.end(), first, last);
+      }
+
+      std::sort(range.begin(), range.end(), [](auto&& lhs, auto&& rhs) {
+        return *lhs.id < *rhs.id or (*lhs.id == *rhs.id and lhs.partial < rhs.partial);
+      });
+
+      for (auto i = size_t{1}; i < range.size(); ++i) {
+        if (*range[i - 1].id == *range[i].id) {
+          keep[range[i].partial][range[i].position] = char{0};
+        }
+      }
+    });
+
+    return keep;
+  }
+
+  // Pick IDs that cut the combined keys into roughly equal-sized ranges, by sampling each partial evenly.
+  static std::vector< const id_type* > _choose_splitters(const std::vector< std::vector< _key > >& keys, size_t range_count) {
+    auto samples = std::vector< const id_type* >{};
+    for (auto&& partial_keys : keys) {
+      const auto step = std::max< size_t >(partial_keys.size() / range_count, 1);
+      for (auto i = step / 2; i < partial_keys.size(); i += step) {
+        samples.push_back(partial_keys[i].id);
+      }
+    }
+
+    std::sort(samples.begin(), samples.end(), [](auto lhs, auto rhs) { return *lhs < *rhs; });
+
+    auto out        = std::vector< const id_type* >{};
+    const auto step = std::max< size_t >(samples.size() / range_count, 1);
+    for (auto i = step; i < samples.size(); i += step) {
+      if (out.empty() or *out.back() < *samples[i]) {
+        out.push_back(samples[i]);
+      }
+    }
+
+    return out;
+  }
+
+  static constexpr size_t _ranges_per_thread = 4;
+
+  std::vector< collection_type > _partials;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
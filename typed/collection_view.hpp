@@ -0,0 +1,159 @@
+#pragma once
+
+#include <typed/detail/collection_access.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// A read-only view of a collection for code that doesn't know the collection's type, such as a plugin. Items are seen
+/// through one of their base classes, Interface_T, and looked up by the value of their IDs, IdValue_T.
+///
+/// Every virtual function works on a whole batch of items: IDs go in as a span and pointers to the items come out in
+/// another, and iteration hands out the items a chunk at a time. So a virtual call costs about the same for a thousand
+/// items as it does for one, and the loops over the items themselves are inside the concrete view, where the compiler
+/// can see the collection's real type.
+/// </summary>
+template < typename Interface_T, typename IdValue_T >
+class identifiable_collection_view {
+ public:
+  using interface_type = Interface_T;
+  using id_value_type  = IdValue_T;
+
+  static constexpr size_t default_chunk_size = 256;
+
+  virtual ~identifiable_collection_view() = default;
+
+  [[nodiscard]] virtual size_t size() const noexcept = 0;
+
+  /// <summary>
+  /// Looks up a batch of IDs: out[i] is set to the item with the ID ids[i], or null if there isn't one. out has to be
+  /// at least as big as ids.
+  /// </summary>
+  virtual void find_many(std::span< const id_value_type > ids, std::span< const interface_type* > out) const = 0;
+
+  /// <summary>
+  /// Fills out with the items at positions first, first + 1, ..., stopping early at the end of the collection. Returns
+  /// the number of items it put in out.
+  /// </summary>
+  virtual size_t read(size_t first, std::span< const interface_type* > out) const = 0;
+
+  /// <summary>
+  /// Calls fn(chunk) for consecutive chunks of the items, in order, where chunk is a span of pointers to items. The
+  /// chunks are read into default_chunk_size pointers on the stack, or into the given buffer, which sets their size and
+  /// can be kept for the next time.
+  /// </summary>
+  template < typename Fn_T >
+  void for_each_chunk(Fn_T&& fn) const {
+    auto buffer = std::array< const interface_type*, default_chunk_size >{};
+    for_each_chunk(std::forward< Fn_T >(fn), buffer);
+  }
+
+  template < typename Fn_T >
+  void for_each_chunk(Fn_T&& fn, std::span< const interface_type* > buffer) const {
+    assert(not buffer.empty());
+
+    for (auto first = size_t{0}, count = read(first, buffer); 0 != count; first += count, count = read(first, buffer)) {
+      fn(std::span< const interface_type* const >{buffer.data(), count});
+    }
+  }
+
+ protected:
+  identifiable_collection_view() = default;
+  identifiable_collection_view(const identifiable_collection_view&) = default;
+  identifiable_collection_view& operator=(const identifiable_collection_view&) = default;
+};
+
+/// <summary>
+/// A collection can only be viewed through a base class of its items (or the items' own type).
+/// </summary>
+template < typename Collection_T, typename Interface_T >
+concept viewable_through = std::convertible_to< const typename Collection_T::value_type*, const Interface_T* >;
+
+/// <summary>
+/// The identifiable_collection_view of a particular type of collection. It refers to the collection, which has to
+/// outlive it. A view of a non-const collection looks items up the way the collection's non-const find_many does, so
+/// the first lookup builds the ID index; a view of a const collection never changes it.
+/// </summary>
+template < typename Collection_T, typename Interface_T >
+requires viewable_through< Collection_T, Interface_T >
+class collection_view final
+    : public identifiable_collection_view< Interface_T, typename Collection_T::id_type::value_type > {
+  using _base_type = identifiable_collection_view< Interface_T, typename Collection_T::id_type::value_type >;
+
+ public:
+  using collection_type = Collection_T;
+  using value_type      = typename collection_type::value_type;
+  using id_type         = typename collection_type::id_type;
+  using typename _base_type::id_value_type;
+  using typename _base_type::interface_type;
+
+  explicit collection_view(collection_type& collection) noexcept : _collection{&collection} {}
+
+  [[nodiscard]] size_t size() const noexcept override { return static_cast< size_t >(_collection->size().get()); }
+
+  // The IDs are wrapped up as the collection's ID type, and the items' pointers converted to the interface, a slice of
+  // the batch at a time, in buffers on the stack.
+  void find_many(std::span< const id_value_type > ids, std::span< const interface_type* > out) const override {
+    using found_type = std::conditional_t< std::is_const_v< collection_type >, const value_type*, value_type* >;
+
+    constexpr auto slice_size = size_t{256};
+
+    auto typed_ids = std::array< id_type, slice_size >{};
+    auto found     = std::array< found_type, slice_size >{};
+    for (auto first = size_t{0}; first < ids.size(); first += slice_size) {
+      const auto count = std::min(slice_size, ids.size() - first);
+
+      const auto slice = ids.subspan(first, count);
+      std::transform(slice.begin(), slice.end(), typed_ids.begin(), [](auto&& id) { return id_type{id}; });
+      _collection->find_many(std::span< const id_type >{typed_ids.data(), count}, std::span{found}.first(count));
+      std::copy_n(found.begin(), count, std::next(out.begin(), first));
+    }
+  }
+
+  // Straight from the collection's own array of pointers to its items.
+  size_t read(size_t first, std::span< const interface_type* > out) const override {
+    const auto& values = detail::collection_access::values(*_collection);
+    if (first >= values.size()) {
+      return 0;
+    }
+
+    const auto count = std::min(out.size(), values.size() - first);
+    const auto from  = std::next(values.begin(), first);
+    std::transform(from, std::next(from, count), out.begin(), [](auto&& val) -> const interface_type* { return val.get(); });
+
+    return count;
+  }
+
+ private:
+  collection_type* _collection;
+};
+
+/// <summary>
+/// Returns a view of the collection, through the items' base class Interface_T, to pass to code that takes an
+/// identifiable_collection_view< Interface_T, ... >. Pass a const collection for a view that never changes it.
+/// </summary>
+template < typename Interface_T, typename Collection_T >
+requires viewable_through< Collection_T, Interface_T >
+[[nodiscard]] collection_view< Collection_T, Interface_T > make_collection_view(Collection_T& collection) noexcept {
+  return collection_view< Collection_T, Interface_T >{collection};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
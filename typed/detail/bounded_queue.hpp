@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// A multi-producer, multi-consumer FIFO queue that blocks producers when it's full and consumers when it's empty. Once
+/// the queue is closed, pushes fail and pops drain whatever is left and then return nullopt.
+/// </summary>
+template < typename T >
+class bounded_queue {
+ public:
+  using value_type = T;
+
+  explicit bounded_queue(size_t capacity) : _capacity{capacity > 0 ? capacity : 1} {}
+
+  bounded_queue(const bounded_queue&)            = delete;
+  bounded_queue& operator=(const bounded_queue&) = delete;
+
+  bool push(value_type value) {
+    auto lock = std::unique_lock{_mutex};
+    _not_full.wait(lock, [this] { return _closed or _values.size() < _capacity; });
+    if (_closed) {
+      return false;
+    }
+
+    _values.push_back(std::move(value));
+    lock.unlock();
+
+    _not_empty.notify_one();
+    return true;
+  }
+
+  [[nodiscard]] std::optional< value_type > pop() {
+    auto lock = std::unique_lock{_mutex};
+    _not_empty.wait(lock, [this] { return _closed or not _values.empty(); });
+    if (_values.empty()) {
+      return std::nullopt;
+    }
+
+    auto out = std::optional< value_type >{std::move(_values.front())};
+    _values.pop_front();
+    lock.unlock();
+
+    _not_full.notify_one();
+    return out;
+  }
+
+  void close() {
+    {
+      auto lock = std::lock_guard{_mutex};
+      _closed   = true;
+    }
+
+    _not_full.notify_all();
+    _not_empty.notify_all();
+  }
+
+ private:
+  const size_t _capacity;
+  bool _closed{false};
+  std::deque< value_type > _values;
+  std::mutex _mutex;
+  std::condition_variable _not_full;
+  std::condition_variable _not_empty;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Records whether something that's built lazily (like a collection's ID index) has been built, in a way that readers
+/// on several threads can check, and build, at once: the first to call run builds it, and the rest wait for that and
+/// then see the finished result. Moving one takes its state, but not its mutex, so it doesn't stop the thing that owns
+/// it from being moved.
+/// </summary>
+class build_once {
+ public:
+  build_once() = default;
+
+  build_once(build_once&& other) noexcept : _built{other.built()} {}
+
+  build_once& operator=(build_once&& other) noexcept {
+    _built.store(other.built(), std::memory_order_release);
+    return *this;
+  }
+
+  [[nodiscard]] bool built() const noexcept { return _built.load(std::memory_order_acquire); }
+
+  template < typename Build_Fn >
+  void run(Build_Fn&& build) {
+    if (built()) {
+      return;
+    }
+
+    auto lock = std::lock_guard{_mutex};
+    if (not _built.load(std::memory_order_relaxed)) {
+      build();
+      _built.store(true, std::memory_order_release);
+    }
+  }
+
+  /// <summary>
+  /// Marks it as not built. Only for use when nothing else can be looking at it.
+  /// </summary>
+  void reset() noexcept { _built.store(false, std::memory_order_release); }
+
+ private:
+  std::atomic< bool > _built{false};
+  std::mutex _mutex;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Lets the library's own algorithms take the storage out of a collection, rearrange it and hand it back, or read it in
+/// place, without making that part of the collection's public interface. The collection rebuilds any lookup structures
+/// when storage is handed back.
+/// </summary>
+struct collection_access {
+  template < typename Collection_T >
+  [[nodiscard]] static auto release(Collection_T& collection) noexcept {
+    return collection._release();
+  }
+
+  template < typename Collection_T >
+  using container_t = decltype(release(std::declval< Collection_T& >()));
+
+  template < typename Collection_T >
+  [[nodiscard]] static const auto& values(const Collection_T& collection) noexcept {
+    return collection._values;
+  }
+
+  template < typename Collection_T >
+  [[nodiscard]] static Collection_T adopt(container_t< Collection_T > values) {
+    return Collection_T{std::move(values)};
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// A single contiguous block of memory with room for a fixed number of items, which a collection moves its items into
+/// when it compacts itself. Every item constructed in the arena holds a reference to it (through its item_deleter), as
+/// does whoever is filling it, and the arena frees itself when the last reference goes.
+/// </summary>
+template < typename T >
+class item_arena {
+ public:
+  /// <summary>
+  /// Returns a new arena with room for capacity items, holding one reference for the caller.
+  /// </summary>
+  [[nodiscard]] static item_arena* create(size_t capacity) { return new item_arena{capacity}; }
+
+  item_arena(const item_arena&) = delete;
+  item_arena& operator=(const item_arena&) = delete;
+
+  [[nodiscard]] size_t capacity() const noexcept { return _capacity; }
+  [[nodiscard]] size_t used() const noexcept { return _used; }
+  [[nodiscard]] size_t live() const noexcept { return _refs.load(std::memory_order_relaxed) - (_filling ? 1 : 0); }
+  [[nodiscard]] bool full() const noexcept { return _used == _capacity; }
+
+  /// <summary>
+  /// Constructs an item in the next free slot, which the caller must then hand to a unique_ptr with an item_deleter
+  /// for this arena. Only the holder of the filling reference may do this.
+  /// </summary>
+  template < typename... Arg_Ts >
+  [[nodiscard]] T* emplace(Arg_Ts&&... args) {
+    auto out = std::construct_at(_slots + _used, std::forward< Arg_Ts >(args)...);
+    ++_used;
+    _refs.fetch_add(1, std::memory_order_relaxed);
+    return out;
+  }
+
+  /// <summary>
+  /// Gives up the reference that create returned: no more items can be added.
+  /// </summary>
+  void finish_filling() noexcept {
+    _filling = false;
+    release();
+  }
+
+  void release() noexcept {
+    if (1 == _refs.fetch_sub(1, std::memory_order_acq_rel)) {
+      delete this;
+    }
+  }
+
+ private:
+  explicit item_arena(size_t capacity) : _slots{std::allocator< T >{}.allocate(capacity)}, _capacity{capacity} {}
+
+  ~item_arena() { std::allocator< T >{}.deallocate(_slots, _capacity); }
+
+  T* _slots;
+  size_t _capacity;
+  size_t _used{0};
+  bool _filling{true};
+  std::atomic< size_t > _refs{1};
+};
+
+/// <summary>
+/// Owns the filling reference to an arena, and gives it up when it goes.
+/// </summary>
+template < typename T >
+struct finish_filling {
+  void operator()(item_arena< T >* arena) const noexcept { arena->finish_filling(); }
+};
+
+template < typename T >
+using arena_filler = std::unique_ptr< item_arena< T >, finish_filling< T > >;
+
+/// <summary>
+/// Deletes an item that is either on the heap, on its own, or in an item_arena. A std::unique_ptr's deleter converts
+/// to one of these, so items that come in as std::unique_ptrs can be stored as is.
+/// </summary>
+template < typename T >
+struct item_deleter {
+  constexpr item_deleter() noexcept = default;
+  constexpr item_deleter(std::default_delete< T >) noexcept {}
+  constexpr explicit item_deleter(item_arena< T >* arena) noexcept : arena{arena} {}
+
+  void operator()(T* item) const noexcept {
+    if (nullptr == arena) {
+      delete item;
+    } else {
+      std::destroy_at(item);
+      arena->release();
+    }
+  }
+
+  item_arena< T >* arena{nullptr};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <typed/key_traits.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Where a collection keeps the packed keys of its items: a flat vector of them if the ID type is packable, or nothing
+/// at all if it isn't.
+/// </summary>
+struct no_keys {};
+
+template < typename Id_T >
+struct key_storage {
+  using type = no_keys;
+};
+
+template < packable_key Id_T >
+struct key_storage< Id_T > {
+  using type = std::vector< packed_key_t< Id_T > >;
+};
+
+template < typename Id_T >
+using key_storage_t = typename key_storage< Id_T >::type;
+
+/// <summary>
+/// What a collection's ID index sorts on: the packed key if the ID type is packable, otherwise a pointer to the ID
+/// itself, which lives inside its item and so doesn't move.
+/// </summary>
+template < typename Id_T >
+struct index_key {
+  using type = const Id_T*;
+};
+
+template < packable_key Id_T >
+struct index_key< Id_T > {
+  using type = packed_key_t< Id_T >;
+};
+
+template < typename Id_T >
+using index_key_t = typename index_key< Id_T >::type;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Returns the position of the first occurrence of key in keys, or keys.size() if it isn't there. The keys are checked
+/// a block at a time, with no early exit inside a block, which compilers can turn into SIMD compares.
+/// </summary>
+template < std::unsigned_integral Key_T >
+[[nodiscard]] size_t find_key(std::span< const Key_T > keys, Key_T key) noexcept {
+  constexpr auto block_size = size_t{64} / sizeof(Key_T);
+
+  auto i = size_t{0};
+  for (; i + block_size <= keys.size(); i += block_size) {
+    auto found = false;
+    for (auto j = size_t{0}; j < block_size; ++j) {
+      found |= keys[i + j] == key;
+    }
+
+    if (found) {
+      break;
+    }
+  }
+
+  for (; i < keys.size(); ++i) {
+    if (keys[i] == key) {
+      return i;
+    }
+  }
+
+  return keys.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Sorts (key, payload) pairs by key with an LSD radix sort, one byte of the key per pass. Passes where every key has
+/// the same byte are skipped, so keys that only use their low bits cost fewer passes. The sort is stable.
+/// </summary>
+template < std::unsigned_integral Key_T, typename Payload_T >
+void radix_sort(std::vector< std::pair< Key_T, Payload_T > >& values) {
+  constexpr auto passes        = sizeof(Key_T);
+  constexpr auto bucket_count  = size_t{256};
+  constexpr auto small_to_sort = size_t{64};
+
+  if (values.size() < small_to_sort) {
+    std::stable_sort(values.begin(), values.end(), [](auto&& lhs, auto&& rhs) { return lhs.first < rhs.first; });
+    return;
+  }
+
+  const auto digit = [](Key_T key, size_t pass) { return static_cast< size_t >((key >> (8 * pass)) & 0xff); };
+
+  auto counts = std::vector< std::array< size_t, bucket_count > >(passes);
+  for (auto&& value : values) {
+    for (auto pass = size_t{0}; pass < passes; ++pass) {
+      ++counts[pass][digit(value.first, pass)];
+    }
+  }
+
+  auto buffer = std::vector< std::pair< Key_T, Payload_T > >(values.size());
+  for (auto pass = size_t{0}; pass < passes; ++pass) {
+    auto& offsets = counts[pass];
+    if (values.size() == offsets[digit(values.front().first, pass)]) {
+      continue;
+    }
+
+    auto total = size_t{0};
+    for (auto&& offset : offsets) {
+      total += std::exchange(offset, total);
+    }
+
+    for (auto&& value : values) {
+      buffer[offsets[digit(value.first, pass)]++] = std::move(value);
+    }
+
+    values.swap(buffer);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Calls fn(i) for every i in [0, task_count), spread over up to thread_count threads (including the calling one).
+/// Tasks are handed out one at a time, so uneven tasks still balance out. If any task throws, the remaining tasks are
+/// skipped and the first exception is rethrown once all the threads have finished.
+/// </summary>
+template < typename Fn_T >
+void run_in_parallel(size_t thread_count, size_t task_count, Fn_T&& fn) {
+  auto next        = std::atomic< size_t >{0};
+  auto error       = std::exception_ptr{};
+  auto error_mutex = std::mutex{};
+
+  auto worker = [&] {
+    try {
+      for (auto i = next++; i < task_count; i = next++) {
+        fn(i);
+      }
+    } catch (...) {
+      next = task_count;
+
+      auto lock = std::lock_guard{error_mutex};
+      if (not error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  {
+    auto threads = std::vector< std::jthread >{};
+    for (auto i = size_t{1}; i < std::min(thread_count, task_count); ++i) {
+      threads.emplace_back(worker);
+    }
+
+    worker();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
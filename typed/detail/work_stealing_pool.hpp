@@ -0,0 +1,348 @@
+#pragma once
+
+#include <typed/index_range.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed::detail {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// A pool of threads that share out the work of splitting and processing index ranges. Each job gives every thread that
+/// joins it (including the one that submitted it) its own deque of ranges: a thread works from the back of its own
+/// deque and, when that runs dry, steals from the front of the others.
+///
+/// Ranges are split lazily: a thread only splits its range, pushing the second half where it can be stolen, when its
+/// own deque is empty. Otherwise it works through its range a chunk at a time. So chunks are only as small as the
+/// balance of work needs them to be: when the load is even, each thread splits a few times and then just works; when
+/// it isn't, threads that run out steal halves of the remaining work from the others.
+///
+/// A pool thread that finds nothing left to steal leaves the job, handing back its slot, and sleeps until some job has
+/// work to steal again, so that it's free to help with a job started from inside another job's body. The thread that
+/// submitted the job sleeps in the same way until its job is done, or there's more of it to steal.
+/// </summary>
+class work_stealing_pool {
+ public:
+  /// <summary>
+  /// A pool with the given number of background threads. Jobs run on up to one more thread than that, since the thread
+  /// that submits a job works on it too.
+  /// </summary>
+  explicit work_stealing_pool(size_t thread_count) {
+    _threads.reserve(thread_count);
+    for (auto i = size_t{0}; i < thread_count; ++i) {
+      _threads.emplace_back([this](std::stop_token stop) { _work(stop); });
+    }
+  }
+
+  work_stealing_pool(const work_stealing_pool&) = delete;
+  work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+  ~work_stealing_pool() {
+    for (auto&& thread : _threads) {
+      thread.request_stop();
+    }
+
+    {
+      auto lock = std::lock_guard{_mutex};
+    }
+    _work_posted.notify_all();
+  }
+
+  /// <summary>
+  /// A pool shared by everything in the process, with a thread for each hardware thread, less one for the caller.
+  /// </summary>
+  [[nodiscard]] static work_stealing_pool& shared() {
+    static auto pool = work_stealing_pool{std::max< size_t >(std::thread::hardware_concurrency(), 1) - 1};
+    return pool;
+  }
+
+  [[nodiscard]] size_t concurrency() const noexcept { return _threads.size() + 1; }
+
+  /// <summary>
+  /// Calls body(slot, chunk) for disjoint chunks that cover the whole range, where slot identifies which of the job's
+  /// threads is running the chunk (and is less than concurrency()). No chunk is larger than grain_size, unless the
+  /// grain size is zero, when one is chosen. Returns once every chunk has been processed. If a call to body throws,
+  /// the remaining chunks are skipped and the first exception is rethrown here.
+  /// </summary>
+  template < typename Index_T, typename Body_Fn >
+  void run(index_range< Index_T > range, size_t grain_size, Body_Fn&& body) {
+    if (range.empty()) {
+      return;
+    }
+
+    if (0 == grain_size) {
+      grain_size = default_grain_size(range.size(), concurrency());
+    }
+
+    auto job = _job< Index_T, Body_Fn >{*this, concurrency(), range, grain_size, body};
+    if (range.size() > grain_size and not _threads.empty()) {
+      auto lock = std::lock_guard{_mutex};
+      _jobs.push_back(&job);
+      _work_posted.notify_all();
+    }
+
+    job.participate(0);
+    while (not job.done()) {
+      _wait_for_work([&job] { return job.done() or job.has_work(); });
+      job.participate(0);
+    }
+
+    // Threads that joined the job may still be on their way out of it.
+    {
+      auto lock = std::unique_lock{_mutex};
+      _jobs.erase(std::remove(_jobs.begin(), _jobs.end(), &job), _jobs.end());
+      _job_left.wait(lock, [&job] { return 0 == job.active; });
+    }
+
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+  /// <summary>
+  /// Enough chunks to give each thread plenty to steal, but no more than needed to amortise the cost of looking for
+  /// work between chunks.
+  /// </summary>
+  [[nodiscard]] static size_t default_grain_size(size_t item_count, size_t concurrency) noexcept {
+    constexpr auto chunks_per_thread = size_t{64};
+    constexpr auto max_grain_size    = size_t{4096};
+    return std::clamp< size_t >(item_count / (chunks_per_thread * concurrency), 1, max_grain_size);
+  }
+
+ private:
+  struct _job_base {
+    _job_base(work_stealing_pool& pool, size_t slot_count) : pool{pool}, slot_count{slot_count} {
+      // Slot 0 belongs to the thread that submitted the job.
+      for (auto slot = slot_count - 1; slot > 0; --slot) {
+        free_slots.push_back(slot);
+      }
+    }
+
+    virtual ~_job_base() = default;
+
+    /// <summary>
+    /// Processes chunks until there are none left to take or steal.
+    /// </summary>
+    virtual void participate(size_t slot) = 0;
+
+    [[nodiscard]] virtual bool has_work() const noexcept = 0;
+    [[nodiscard]] virtual bool done() const noexcept     = 0;
+
+    work_stealing_pool& pool;
+    const size_t slot_count;
+
+    // Guarded by the pool's mutex.
+    std::vector< size_t > free_slots;
+    size_t active{0};
+  };
+
+  template < typename Index_T, typename Body_Fn >
+  struct _job final : _job_base {
+    using range_type = index_range< Index_T >;
+
+    struct slot_type {
+      std::mutex mutex;
+      std::deque< range_type > ranges;
+      std::atomic< size_t > count{0};
+    };
+
+    _job(work_stealing_pool& pool, size_t slot_count, range_type range, size_t grain_size, Body_Fn& body)
+        : _job_base{pool, slot_count}
+        , slots(slot_count)
+        , remaining{range.size()}
+        , grain_size{grain_size}
+        , body{body} {
+      push(0, range);
+    }
+
+    void participate(size_t slot) override {
+      while (true) {
+        auto range = pop(slot);
+        for (auto victim = slot + 1; not range and victim < slot + slot_count; ++victim) {
+          range = steal(victim % slot_count);
+        }
+
+        if (not range) {
+          return;
+        }
+
+        process(slot, *range);
+      }
+    }
+
+    [[nodiscard]] bool has_work() const noexcept override {
+      return std::any_of(slots.begin(), slots.end(), [](auto&& s) { return 0 != s.count.load(); });
+    }
+
+    [[nodiscard]] bool done() const noexcept override { return 0 == remaining.load(); }
+
+    void process(size_t slot, range_type range) {
+      while (not range.empty()) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+          finish(range.size());
+          return;
+        }
+
+        if (range.size() > grain_size and 0 == slots[slot].count.load(std::memory_order_relaxed)) {
+          push(slot, range.split());
+          continue;
+        }
+
+        // Clamped first, since the grain size may not fit in a narrow index type.
+        const auto chunk = range.take_front(static_cast< typename range_type::size_type >(
+            std::min< size_t >(grain_size, static_cast< size_t >(range.size()))));
+        try {
+          body(slot, chunk);
+        } catch (...) {
+          auto lock = std::lock_guard{error_mutex};
+          if (not error) {
+            error = std::current_exception();
+          }
+          cancelled = true;
+        }
+
+        finish(chunk.size());
+      }
+    }
+
+    void finish(size_t count) {
+      if (count == remaining.fetch_sub(count)) {
+        pool._wake_sleepers();
+      }
+    }
+
+    void push(size_t slot, range_type range) {
+      {
+        auto lock = std::lock_guard{slots[slot].mutex};
+        slots[slot].ranges.push_back(range);
+        ++slots[slot].count;
+      }
+
+      pool._wake_sleepers();
+    }
+
+    std::optional< range_type > pop(size_t slot) { return take(slot, false); }
+    std::optional< range_type > steal(size_t slot) { return take(slot, true); }
+
+    std::optional< range_type > take(size_t slot, bool from_front) {
+      auto& s = slots[slot];
+      if (0 == s.count.load(std::memory_order_relaxed)) {
+        return std::nullopt;
+      }
+
+      auto lock = std::lock_guard{s.mutex};
+      if (s.ranges.empty()) {
+        return std::nullopt;
+      }
+
+      auto out = from_front ? s.ranges.front() : s.ranges.back();
+      from_front ? s.ranges.pop_front() : s.ranges.pop_back();
+      --s.count;
+      return out;
+    }
+
+    std::vector< slot_type > slots;
+    std::atomic< size_t > remaining;
+    const size_t grain_size;
+    Body_Fn& body;
+
+    std::atomic< bool > cancelled{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  // Sleeps until ready() is true. Whatever makes it true has to call _wake_sleepers afterwards: the sleeper is counted
+  // before it checks, and the waker checks the count after, so one of them sees the other.
+  template < typename Ready_Fn >
+  void _wait_for_work(Ready_Fn&& ready, std::unique_lock< std::mutex >& lock) {
+    ++_sleepers;
+    _work_posted.wait(lock, ready);
+    --_sleepers;
+  }
+
+  template < typename Ready_Fn >
+  void _wait_for_work(Ready_Fn&& ready) {
+    auto lock = std::unique_lock{_mutex};
+    _wait_for_work(ready, lock);
+  }
+
+  void _wake_sleepers() {
+    if (0 != _sleepers.load()) {
+      {
+        auto lock = std::lock_guard{_mutex};
+      }
+      _work_posted.notify_all();
+    }
+  }
+
+  void _work(std::stop_token stop) {
+    while (true) {
+      auto job  = static_cast< _job_base* >(nullptr);
+      auto slot = size_t{0};
+      {
+        auto lock = std::unique_lock{_mutex};
+        _wait_for_work(
+            [&] {
+              if (stop.stop_requested()) {
+                return true;
+              }
+
+              // The newest job first, so that a job started from inside another job's body gets help.
+              for (auto it = _jobs.rbegin(); _jobs.rend() != it; ++it) {
+                if (not(*it)->free_slots.empty() and (*it)->has_work()) {
+                  job = *it;
+                  return true;
+                }
+              }
+
+              return false;
+            },
+            lock);
+
+        if (nullptr == job) {
+          return;
+        }
+
+        slot = job->free_slots.back();
+        job->free_slots.pop_back();
+        ++job->active;
+      }
+
+      job->participate(slot);
+
+      {
+        auto lock = std::lock_guard{_mutex};
+        job->free_slots.push_back(slot);
+        --job->active;
+      }
+      _job_left.notify_all();
+    }
+  }
+
+  std::mutex _mutex;
+  std::condition_variable _work_posted;
+  std::condition_variable _job_left;
+  std::atomic< size_t > _sleepers{0};
+  std::vector< _job_base* > _jobs;
+  std::vector< std::jthread > _threads;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed::detail
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <typed/key_traits.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+[[nodiscard]] constexpr std::uint64_t byteswap(std::uint64_t x) noexcept {
+  x = ((x & 0x00ff00ff00ff00ffull) << 8) | ((x >> 8) & 0x00ff00ff00ff00ffull);
+  x = ((x & 0x0000ffff0000ffffull) << 16) | ((x >> 16) & 0x0000ffff0000ffffull);
+  return (x << 32) | (x >> 32);
+}
+
+}  // namespace detail
+
+/// <summary>
+/// A string of up to N characters, stored inline rather than on the heap, for use as the value type of short string IDs.
+/// It's trivially copyable and the unused characters are always zero, so copying one is a memcpy, and comparing and
+/// hashing it works through the characters eight at a time. Strings order the same way as the equivalent std::strings,
+/// but can't contain '\0'.
+///
+/// Strings of up to eight characters are packable keys (see key_traits.hpp), so collections sort them with a radix sort
+/// and search them by scanning a flat array of integers.
+/// </summary>
+template < size_t N >
+class fixed_string {
+  static_assert(N > 0, "A fixed_string must have room for at least one character");
+
+ public:
+  using value_type = char;
+  using size_type  = size_t;
+
+  constexpr fixed_string() noexcept = default;
+
+  /// <summary>
+  /// Construction from a string literal is checked at compile time: a literal that's too long picks the deleted
+  /// overload, rather than going through the string_view constructor and throwing. A char array holds the string up to
+  /// its first '\0', and whatever comes after that is ignored, so the rest of the characters stay zero.
+  /// </summary>
+  template < size_t M >
+  requires(M <= N + 1) constexpr fixed_string(const char (&str)[M]) noexcept {
+    std::copy(str, std::find(str, str + M - 1, '\0'), _chars.begin());
+  }
+
+  template < size_t M >
+  requires(M > N + 1) fixed_string(const char (&str)[M]) = delete;
+
+  /// <summary>
+  /// Throws std::length_error if the string is longer than N, or std::invalid_argument if it contains a '\0'.
+  /// </summary>
+  constexpr explicit fixed_string(std::string_view str) {
+    if (str.size() > N) {
+      throw std::length_error{"String is too long for a fixed_string"};
+    }
+
+    if (std::string_view::npos != str.find('\0')) {
+      throw std::invalid_argument{"A fixed_string can't contain '\\0'"};
+    }
+
+    std::copy(str.begin(), str.end(), _chars.begin());
+  }
+
+  [[nodiscard]] static constexpr size_type max_size() noexcept { return N; }
+
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return static_cast< size_type >(std::distance(_chars.begin(), std::find(_chars.begin(), _chars.begin() + N, '\0')));
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return '\0' == _chars[0]; }
+
+  [[nodiscard]] constexpr const char* data() const noexcept { return _chars.data(); }
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept { return {_chars.data(), size()}; }
+
+  [[nodiscard]] constexpr bool starts_with(std::string_view prefix) const noexcept { return view().starts_with(prefix); }
+
+  [[nodiscard]] friend constexpr bool operator==(const fixed_string& lhs, const fixed_string& rhs) noexcept {
+    if (std::is_constant_evaluated()) {
+      return lhs._chars == rhs._chars;
+    }
+
+    auto differences = std::uint64_t{0};
+    for (auto w = size_t{0}; w < _word_count; ++w) {
+      differences |= lhs._word(w) ^ rhs._word(w);
+    }
+
+    return 0 == differences;
+  }
+
+  /// <summary>
+  /// Compares the first words that differ as big-endian integers, which orders them the same way as comparing their
+  /// characters one at a time, as unsigned chars.
+  /// </summary>
+  [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const fixed_string& lhs, const fixed_string& rhs) noexcept {
+    if (std::is_constant_evaluated()) {
+      for (auto i = size_t{0}; i < N; ++i) {
+        if (lhs._chars[i] != rhs._chars[i]) {
+          return static_cast< unsigned char >(lhs._chars[i]) <=> static_cast< unsigned char >(rhs._chars[i]);
+        }
+      }
+
+      return std::strong_ordering::equal;
+    }
+
+    for (auto w = size_t{0}; w < _word_count; ++w) {
+      const auto l = lhs._word(w);
+      const auto r = rhs._word(w);
+      if (l != r) {
+        return _big_endian(l) <=> _big_endian(r);
+      }
+    }
+
+    return std::strong_ordering::equal;
+  }
+
+  /// <summary>
+  /// Mixes the string into a hash a word at a time.
+  /// </summary>
+  [[nodiscard]] size_t hash() const noexcept {
+    auto out = std::uint64_t{N};
+    for (auto w = size_t{0}; w < _word_count; ++w) {
+      out = detail::mix_bits(out ^ _word(w));
+    }
+
+    return static_cast< size_t >(out);
+  }
+
+  /// <summary>
+  /// The first (up to) eight characters as a big-endian integer, so that they sort as the string does.
+  /// </summary>
+  [[nodiscard]] constexpr std::uint64_t prefix_key() const noexcept {
+    auto out = std::uint64_t{0};
+    for (auto i = size_t{0}; i < sizeof(std::uint64_t); ++i) {
+      out = (out << 8) | static_cast< unsigned char >(_chars[i]);
+    }
+
+    return out;
+  }
+
+ private:
+  static constexpr size_t _word_count = (N + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  [[nodiscard]] std::uint64_t _word(size_t w) const noexcept {
+    auto out = std::uint64_t{0};
+    std::memcpy(&out, _chars.data() + w * sizeof(std::uint64_t), sizeof(out));
+    return out;
+  }
+
+  [[nodiscard]] static constexpr std::uint64_t _big_endian(std::uint64_t word) noexcept {
+    if constexpr (std::endian::little == std::endian::native) {
+      return detail::byteswap(word);
+    } else {
+      return word;
+    }
+  }
+
+  // Padded out to a whole number of words, which are always zero past the end of the string.
+  std::array< char, _word_count * sizeof(std::uint64_t) > _chars{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Up to eight characters pack into the smallest unsigned integer they fit in, taking the characters as the digits of a
+/// big-endian number.
+/// </summary>
+template < size_t N >
+requires(N <= sizeof(std::uint64_t)) struct key_traits< fixed_string< N > > {
+  using key_type = std::conditional_t< N <= 1,
+                                       std::uint8_t,
+                                       std::conditional_t< N <= 2,
+                                                           std::uint16_t,
+                                                           std::conditional_t< N <= 4, std::uint32_t, std::uint64_t > > >;
+
+  [[nodiscard]] static constexpr key_type pack(const fixed_string< N >& str) noexcept {
+    return static_cast< key_type >(str.prefix_key() >> (8 * (sizeof(std::uint64_t) - sizeof(key_type))));
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
+
+template < size_t N >
+struct std::hash< typed::fixed_string< N > > {
+  [[nodiscard]] size_t operator()(const typed::fixed_string< N >& str) const noexcept { return str.hash(); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
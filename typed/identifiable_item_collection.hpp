@@ -1,9 +1,27 @@
 #pragma once
 
+#include <typed/detail/build_once.hpp>
+#include <typed/detail/collection_access.hpp>
+#include <typed/detail/item_arena.hpp>
+#include <typed/detail/key_scan.hpp>
+#include <typed/detail/prefetch.hpp>
+#include <typed/detail/radix_sort.hpp>
 #include <typed/index.hpp>
+#include <typed/key_traits.hpp>
+#include <typed/secondary_index.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
 #include <map>
+#include <iterator>
 #include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -13,11 +31,12 @@ namespace typed {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template < typename Item_T, typename Index_T = size_t >
+template < typename Item_T, typename Index_T = size_t, typename... SecondaryIndex_Ts >
 class identifiable_item_collection {
-  using _this_type      = identifiable_item_collection< Item_T, Index_T >;
+  using _this_type      = identifiable_item_collection< Item_T, Index_T, SecondaryIndex_Ts... >;
   using _ptr_type       = std::unique_ptr< Item_T >;
-  using _container_type = std::vector< _ptr_type >;
+  using _stored_type    = std::unique_ptr< Item_T, detail::item_deleter< Item_T > >;
+  using _container_type = std::vector< _stored_type >;
 
  public:
   using value_type = Item_T;
@@ -25,6 +44,42 @@ class identifiable_item_collection {
   using size_type  = index_type;
   using id_type    = typename value_type::id_type;
 
+  /// <summary>
+  /// Describes the ID index. Until the index is built, lookups scan the collection. Once it's built, items that are
+  /// added are pending: they go into a short sorted list of their own (no longer than about the square root of the size
+  /// of the index), which is merged into the index whenever it fills up. Lookups binary-search the index and then the
+  /// pending items.
+  /// </summary>
+  struct index_state_type {
+    bool built{false};
+    size_type indexed{0};
+    size_type pending{0};
+  };
+
+  /// <summary>
+  /// The memory that the collection is using, in bytes. The secondary indexes are node-based standard containers, which
+  /// don't say how much they've allocated, so their share is an estimate. So is the overhead: the allocator's header and
+  /// rounding up for each item that was allocated on its own, which is most of what compacting them saves. It assumes
+  /// the usual heap layout, a size_t in front of each block and sizes rounded up to a multiple of two pointers.
+  ///
+  /// Unused memory is allocated but not holding anything: spare capacity in the containers, and slots in the blocks
+  /// that compaction moves items into whose items have since been removed. Fragmentation is the fraction of pairs of
+  /// neighbouring items that aren't next to each other in memory: 1 for items allocated one at a time, down to 0 for a
+  /// freshly compacted collection.
+  /// </summary>
+  struct memory_usage_type {
+    size_t items{0};
+    size_t containers{0};
+    size_t indexes{0};
+    size_t overhead{0};
+    size_t unused{0};
+    double fragmentation{0};
+
+    [[nodiscard]] size_t total() const noexcept { return items + containers + indexes + overhead; }
+  };
+
+  identifiable_item_collection() = default;
+
   [[nodiscard]] constexpr size_type size() const noexcept {
     return size_type{static_cast< typename size_type::value_type >(_values.size())};
   }
@@ -32,12 +87,24 @@ class identifiable_item_collection {
   [[nodiscard]] constexpr size_type count() const noexcept { return size(); }
 
   std::pair< value_type* const, bool > add(_ptr_type&& val) {
-    auto out = find(val->id());
-    if (nullptr != out) {
-      return {out, false};
+    const auto idx = _find_index(val->id());
+    if (idx != _values.size()) {
+      return {_values[idx].get(), false};
+    }
+
+    if (const auto conflict = _secondary_conflict(*val); nullptr != conflict) {
+      return {conflict, false};
     }
 
-    return {_unchecked_add(std::move(val)), true};
+    auto out = _unchecked_add(_stored_type{std::move(val)});
+    if (_index_built.built()) {
+      _add_pending(_values.size() - 1);
+      if (_pending.size() > _max_pending()) {
+        _merge_pending();
+      }
+    }
+
+    return {out, true};
   }
 
   std::pair< value_type* const, bool > add(value_type val) { return add(std::make_unique< value_type >(std::move(val))); }
@@ -55,34 +122,681 @@ class identifiable_item_collection {
     return idx != _values.size() ? _values[idx].get() : nullptr;
   }
 
+  /// <summary>
+  /// The non-const lookups build the ID index the first time they're called. The const lookups never change the
+  /// collection: they use the index if there is one, and otherwise scan. Either kind can be called from several threads
+  /// at once (as long as nothing is adding or removing items); if several threads need the index at the same time, one
+  /// builds it while the others wait.
+  /// </summary>
   [[nodiscard]] constexpr value_type* const find(const id_type& id) {
+    _prepare_index();
     return const_cast< value_type* >(const_cast< const _this_type* >(this)->find(id));
   }
 
+  /// <summary>
+  /// Looks up a whole batch of IDs at once. The item with ids[i] is written to out[i], or nullptr if there is no such
+  /// item. With a big index and a big enough batch, the batch is searched in groups, with the steps of the searches in
+  /// a group interleaved and the next probes prefetched, so that the cache misses overlap; otherwise each ID gets a
+  /// binary search of its own. Without an index, the batch is resolved in a single pass over the collection. The output
+  /// span must be at least as long as the input span.
+  /// </summary>
+  void find_many(std::span< const id_type > ids, std::span< const value_type* > out) const { _find_many(ids, out); }
+
+  void find_many(std::span< const id_type > ids, std::span< value_type* > out) {
+    _prepare_index();
+    _find_many(ids, out);
+  }
+
+  [[nodiscard]] index_state_type index_state() const noexcept {
+    const auto indexed = _index_built.built() ? _index.size() : 0;
+    return {_index_built.built(),
+            size_type{static_cast< typename size_type::value_type >(indexed)},
+            size_type{static_cast< typename size_type::value_type >(_values.size() - indexed)}};
+  }
+
+  /// <summary>
+  /// Builds the ID index now, if it isn't already built, and merges in any pending items.
+  /// </summary>
+  void build_index() {
+    _prepare_index();
+    _merge_pending();
+  }
+
+  /// <summary>
+  /// Throws the index away, e.g. before a big batch of adds. It's rebuilt by the next non-const lookup.
+  /// </summary>
+  void drop_index() noexcept {
+    _index   = {};
+    _pending = {};
+    _index_built.reset();
+  }
+
+  /// <summary>
+  /// Returns the secondary index with the given tag (see secondary_index.hpp).
+  /// </summary>
+  template < typename Tag_T >
+  [[nodiscard]] const auto& by() const noexcept {
+    return std::get< _secondary_position< Tag_T >() >(_secondary_indexes);
+  }
+
+  template < typename Tag_T >
+  [[nodiscard]] auto& by() noexcept {
+    return std::get< _secondary_position< Tag_T >() >(_secondary_indexes);
+  }
+
+  /// <summary>
+  /// Removes the item with the given ID and hands it back, or returns null if there isn't one. An item that compact
+  /// has moved is moved out onto the heap on its own, so the pointer that comes back is a different one.
+  /// </summary>
   _ptr_type remove(const id_type& id) {
     auto idx = _find_index(id);
     if (_values.size() == idx) {
       return nullptr;
     }
 
+    if (_index_built.built()) {
+      _remove_from_index(idx);
+    }
+
+    _erase_from_secondary_indexes(*_values[idx]);
+
+    if (_compaction_arena) {
+      _compaction_next -= idx < _compaction_next ? 1 : 0;
+      _compaction_end -= idx < _compaction_end ? 1 : 0;
+    }
+
     auto out = std::move(_values[idx]);
     _values.erase(std::next(_values.begin(), idx));
+    if constexpr (_has_packed_keys) {
+      _keys.erase(std::next(_keys.begin(), idx));
+    }
+
+    return _to_heap(std::move(out));
+  }
+
+  [[nodiscard]] memory_usage_type memory_usage() const {
+    auto out = memory_usage_type{};
+
+    out.items = _values.size() * sizeof(value_type);
+
+    out.containers = _values.capacity() * sizeof(_stored_type);
+    out.unused     = (_values.capacity() - _values.size()) * sizeof(_stored_type);
+    if constexpr (_has_packed_keys) {
+      out.containers += _keys.capacity() * sizeof(typename decltype(_keys)::value_type);
+      out.unused += (_keys.capacity() - _keys.size()) * sizeof(typename decltype(_keys)::value_type);
+    }
+
+    out.indexes = (_index.capacity() + _pending.capacity()) * sizeof(_index_entry_type);
+    out.unused += (_index.capacity() - _index.size() + _pending.capacity() - _pending.size()) * sizeof(_index_entry_type);
+    std::apply([&out](auto&... indexes) { ((out.indexes += indexes.memory_usage()), ...); }, _secondary_indexes);
+
+    auto arenas = std::vector< detail::item_arena< value_type >* >{};
+    for (auto&& val : _values) {
+      if (nullptr != val.get_deleter().arena) {
+        arenas.push_back(val.get_deleter().arena);
+      } else {
+        out.overhead += _heap_overhead();
+      }
+    }
+
+    std::sort(arenas.begin(), arenas.end());
+    arenas.erase(std::unique(arenas.begin(), arenas.end()), arenas.end());
+    for (auto&& arena : arenas) {
+      const auto wasted = (arena->capacity() - arena->live()) * sizeof(value_type);
+      out.items += wasted;
+      out.unused += wasted;
+    }
+
+    if (_values.size() > 1) {
+      auto scattered = size_t{0};
+      for (auto i = size_t{1}; i < _values.size(); ++i) {
+        scattered += _values[i - 1].get() + 1 != _values[i].get() ? 1 : 0;
+      }
+
+      out.fragmentation = static_cast< double >(scattered) / static_cast< double >(_values.size() - 1);
+    }
 
     return out;
   }
 
+  /// <summary>
+  /// Moves the items, in order, into a single new block of memory. Pointers to the items that get moved don't point to
+  /// them any more, but indices still do. This runs for about as long as the given budget and then returns, so that a
+  /// big collection can be compacted a slice at a time, in between other work; it returns true once compaction is
+  /// complete. The collection can be used as normal between slices, and items added part way through are left where they
+  /// are.
+  ///
+  /// Items are moved a few at a time, so a slice only overruns its budget by the time it takes to move a few of them (or
+  /// however long the allocator takes to tidy up its heap, if freeing an item's old memory sets it off). It doesn't trim
+  /// the containers, since that copies each of them in one go: call shrink_to_fit for that, when a pause is acceptable.
+  ///
+  /// Only items that can be move-constructed, and whose type is exactly value_type rather than something derived from
+  /// it, are moved. An item that has been moved is moved back onto the heap on its own when it's removed.
+  /// </summary>
+  bool compact(std::chrono::nanoseconds budget) {
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr auto moves_between_clock_checks = size_t{64};
+
+    const auto start = clock_type::now();
+    if (not _compaction_arena) {
+      _compaction_arena.reset(detail::item_arena< value_type >::create(std::max< size_t >(_values.size(), 1)));
+      _compaction_next = 0;
+      _compaction_end  = _values.size();
+    }
+
+    // Every slice moves something, however small the budget, so that compaction always gets there in the end.
+    while (_compaction_next < _compaction_end) {
+      const auto last = std::min(_compaction_end, _compaction_next + moves_between_clock_checks);
+      for (; _compaction_next < last; ++_compaction_next) {
+        _move_to_arena(_compaction_next);
+      }
+
+      if (clock_type::now() - start >= budget) {
+        return false;
+      }
+    }
+
+    _compaction_arena.reset();
+    return true;
+  }
+
+  /// <summary>
+  /// Compacts the collection in one go, then trims it with shrink_to_fit.
+  /// </summary>
+  void compact() {
+    compact(std::chrono::nanoseconds::max());
+    shrink_to_fit();
+  }
+
+  /// <summary>
+  /// Gives back the spare capacity of the containers and indexes. Each of them is copied, or rehashed, in one go, so this
+  /// takes about as long as copying the whole collection.
+  /// </summary>
+  void shrink_to_fit() {
+    _values.shrink_to_fit();
+    if constexpr (_has_packed_keys) {
+      _keys.shrink_to_fit();
+    }
+
+    _index.shrink_to_fit();
+    _pending.shrink_to_fit();
+    std::apply([](auto&... indexes) { (indexes._shrink(), ...); }, _secondary_indexes);
+  }
+
  private:
+  friend struct detail::collection_access;
+
+  static constexpr bool _has_packed_keys       = packable_key< id_type >;
+  static constexpr bool _has_secondary_indexes = sizeof...(SecondaryIndex_Ts) > 0;
+
+  // The allocator's header and rounding up for an item allocated on its own, assuming the usual heap layout.
+  [[nodiscard]] static constexpr size_t _heap_overhead() noexcept {
+    constexpr auto granule = 2 * sizeof(void*);
+    constexpr auto block   = std::max(2 * granule, (sizeof(value_type) + sizeof(size_t) + granule - 1) / granule * granule);
+    return block - sizeof(value_type);
+  }
+
+  // The index is a sorted list of (key, position) pairs, covering positions [0, _index.size()); the items after that
+  // are pending, and have a sorted list of their own. Packable IDs are indexed by their packed key, anything else by a
+  // pointer to the ID inside the item.
+  using _index_key_type   = detail::index_key_t< id_type >;
+  using _index_entry_type = std::pair< _index_key_type, size_t >;
+
+  // Items that clash with an earlier item in a unique secondary index are dropped, just as add would reject them.
+  explicit identifiable_item_collection(_container_type values) : _values{std::move(values)} {
+    if constexpr (_has_secondary_indexes) {
+      auto kept = size_t{0};
+      for (auto i = size_t{0}; i < _values.size(); ++i) {
+        if (nullptr == _secondary_conflict(*_values[i])) {
+          _insert_into_secondary_indexes(_values[i].get());
+          std::swap(_values[kept++], _values[i]);
+        }
+      }
+
+      _values.resize(kept);
+    }
+
+    if constexpr (_has_packed_keys) {
+      _keys.reserve(_values.size());
+      std::transform(_values.begin(), _values.end(), std::back_inserter(_keys), [](auto&& val) { return pack_key(val->id()); });
+    }
+  }
+
+  _container_type _release() noexcept {
+    _compaction_arena.reset();
+    _keys = {};
+    drop_index();
+    std::apply([](auto&... indexes) { (indexes._clear(), ...); }, _secondary_indexes);
+    return std::exchange(_values, _container_type{});
+  }
+
+  static constexpr size_t _prefetch_distance = 8;
+
+  // Matching an item against a sorted batch costs a handful of dependent comparisons, so for small batches it's cheaper
+  // to just walk the collection for each ID in turn.
+  static constexpr size_t _min_batch_scan_size = 256;
+
+  template < typename Ptr_T >
+  void _find_many(std::span< const id_type > ids, std::span< Ptr_T > out) const {
+    assert(out.size() >= ids.size());
+
+    std::fill_n(out.begin(), ids.size(), nullptr);
+    if (ids.empty() or _values.empty()) {
+      return;
+    }
+
+    if (_index_built.built()) {
+      if (_worth_searching_in_lock_step(ids.size())) {
+        _find_many_indexed(ids, out);
+      } else {
+        std::transform(ids.begin(), ids.end(), out.begin(), [this](auto&& id) {
+          const auto idx = _find_index(id);
+          return idx != _values.size() ? _values[idx].get() : nullptr;
+        });
+      }
+
+      return;
+    }
+
+    if (ids.size() < _min_batch_scan_size) {
+      std::transform(ids.begin(), ids.end(), out.begin(), [this](auto&& id) {
+        const auto idx = _find_index(id);
+        return idx != _values.size() ? _values[idx].get() : nullptr;
+      });
+      return;
+    }
+
+    // Sort the batch by ID (keeping track of where each ID came from), so that each item can be matched against the
+    // whole batch with a binary search. Duplicate IDs in the batch end up next to each other and all get the same result.
+    if constexpr (_has_packed_keys) {
+      auto batch = std::vector< std::pair< packed_key_t< id_type >, size_t > >(ids.size());
+      for (auto i = size_t{0}; i < ids.size(); ++i) {
+        batch[i] = {pack_key(ids[i]), i};
+      }
+
+      detail::radix_sort(batch);
+      _match_batch(
+          batch, [](auto&& entry) { return entry.first; }, [this](auto i) { return _keys[i]; }, out);
+    } else {
+      auto batch = std::vector< std::pair< const id_type*, size_t > >(ids.size());
+      for (auto i = size_t{0}; i < ids.size(); ++i) {
+        batch[i] = {&ids[i], i};
+      }
+
+      std::sort(batch.begin(), batch.end(), [](auto&& lhs, auto&& rhs) { return *lhs.first < *rhs.first; });
+      _match_batch(
+          batch,
+          [](auto&& entry) -> const id_type& { return *entry.first; },
+          [this](auto i) -> const id_type& {
+            if (i + _prefetch_distance < _values.size()) {
+              detail::prefetch(_values[i + _prefetch_distance].get());
+            }
+
+            return _values[i]->id();
+          },
+          out);
+    }
+  }
+
+  template < typename Batch_T, typename BatchKey_Fn, typename ItemKey_Fn, typename Ptr_T >
+  void _match_batch(const Batch_T& batch, BatchKey_Fn&& batch_key, ItemKey_Fn&& item_key, std::span< Ptr_T > out) const {
+    auto remaining = size_t{1};
+    for (auto i = size_t{1}; i < batch.size(); ++i) {
+      remaining += batch_key(batch[i - 1]) != batch_key(batch[i]) ? 1 : 0;
+    }
+
+    for (auto i = size_t{0}; i < _values.size() and remaining > 0; ++i) {
+      // Most items won't be in the batch, so the search is written without branches on the comparisons, which the CPU
+      // would otherwise mispredict about half the time.
+      const auto& key = item_key(i);
+      auto match      = batch.data();
+      for (auto len = batch.size(); len > 1;) {
+        const auto half = len / 2;
+        match += batch_key(match[half - 1]) < key ? half : 0;
+        len -= half;
+      }
+      match += batch_key(*match) < key ? 1 : 0;
+
+      const auto end = batch.data() + batch.size();
+      if (end == match or batch_key(*match) != key) {
+        continue;
+      }
+
+      for (; end != match and batch_key(*match) == key; ++match) {
+        out[match->second] = _values[i].get();
+      }
+
+      --remaining;
+    }
+  }
+
   typename _container_type::size_type _find_index(const id_type& id) const {
-    return std::distance(_values.begin(),
-                         std::find_if(_values.begin(), _values.end(), [&id](auto&& val) { return val->id() == id; }));
+    if (not _index_built.built()) {
+      return _scan(0, id);
+    }
+
+    const auto key = _lookup_key(id);
+    if (const auto match = _search(_index, key); _index.end() != match) {
+      return match->second;
+    }
+
+    const auto match = _search(_pending, key);
+    return _pending.end() != match ? match->second : _values.size();
+  }
+
+  typename _container_type::size_type _scan(size_t from, const id_type& id) const {
+    if constexpr (_has_packed_keys) {
+      return from + detail::find_key(std::span{_keys}.subspan(from), pack_key(id));
+    } else {
+      return std::distance(_values.begin(), std::find_if(std::next(_values.begin(), from), _values.end(), [&id](auto&& val) {
+                             return val->id() == id;
+                           }));
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // The ID index
+  //
+  ///////////////////////////////////////////////////////////////////////////////
+
+  // Adding an item costs a shift of the pending list to make room for it, and a share of the next merge, which moves
+  // the whole index. Letting the pending list grow to about the square root of the size of the index balances the two,
+  // so each add costs O(sqrt(n)) moves of index entries, on top of O(log(n)) comparisons to check it isn't a duplicate.
+  static constexpr size_t _min_pending_to_merge = 32;
+
+  [[nodiscard]] size_t _max_pending() const noexcept {
+    return std::max(_min_pending_to_merge, static_cast< size_t >(std::sqrt(static_cast< double >(_index.size()))));
+  }
+
+  [[nodiscard]] static _index_key_type _lookup_key(const id_type& id) noexcept {
+    if constexpr (_has_packed_keys) {
+      return pack_key(id);
+    } else {
+      return &id;
+    }
+  }
+
+  [[nodiscard]] static bool _key_less(const _index_key_type& lhs, const _index_key_type& rhs) noexcept {
+    if constexpr (_has_packed_keys) {
+      return lhs < rhs;
+    } else {
+      return *lhs < *rhs;
+    }
+  }
+
+  [[nodiscard]] static bool _key_equal(const _index_key_type& lhs, const _index_key_type& rhs) noexcept {
+    if constexpr (_has_packed_keys) {
+      return lhs == rhs;
+    } else {
+      return *lhs == *rhs;
+    }
+  }
+
+  [[nodiscard]] _index_entry_type _entry_for(size_t position) const noexcept {
+    if constexpr (_has_packed_keys) {
+      return {_keys[position], position};
+    } else {
+      return {&_values[position]->id(), position};
+    }
+  }
+
+  // The entry with the given key, or the end of the entries if there isn't one.
+  template < typename Entries_T >
+  [[nodiscard]] static auto _search(Entries_T& entries, const _index_key_type& key) noexcept {
+    const auto match = std::lower_bound(entries.begin(), entries.end(), key, [](auto&& entry, auto&& k) {
+      return _key_less(entry.first, k);
+    });
+
+    return entries.end() != match and _key_equal(match->first, key) ? match : entries.end();
+  }
+
+  // Safe to call from several threads at once: see build_once.
+  void _prepare_index() {
+    _index_built.run([this] {
+      _index.clear();
+      _pending.clear();
+      _merge_pending();
+    });
   }
 
-  value_type* _unchecked_add(_ptr_type&& val) {
-    _values.push_back(std::forward< _ptr_type >(val));
+  // Puts all the items that aren't in the index (or in the pending list) into the pending list, and then merges that
+  // into the index.
+  void _merge_pending() {
+    const auto covered = _index.size() + _pending.size();
+    if (covered < _values.size()) {
+      auto added = std::vector< _index_entry_type >{};
+      added.reserve(_values.size() - covered);
+      for (auto i = covered; i < _values.size(); ++i) {
+        added.push_back(_entry_for(i));
+      }
+
+      if constexpr (_has_packed_keys) {
+        detail::radix_sort(added);
+      } else {
+        std::sort(added.begin(), added.end(), [](auto&& lhs, auto&& rhs) { return _key_less(lhs.first, rhs.first); });
+      }
+
+      _merge_into(_pending, added);
+    }
+
+    _merge_into(_index, _pending);
+    _pending.clear();
+  }
+
+  // Merges a short sorted list into a long one, from the back: each new entry's place is found with a binary search, and
+  // the run of old entries after it is moved up in one go. So a merge compares keys O(sorted.size() * log(n)) times,
+  // rather than comparing (and, for unpackable IDs, dereferencing) every old entry.
+  static void _merge_into(std::vector< _index_entry_type >& entries, const std::vector< _index_entry_type >& sorted) {
+    const auto less = [](auto&& lhs, auto&& rhs) { return _key_less(lhs.first, rhs.first); };
+
+    auto old_end = entries.size();
+    entries.resize(entries.size() + sorted.size());
+    auto dest = entries.end();
+    for (auto it = sorted.rbegin(); sorted.rend() != it; ++it) {
+      const auto old_first = entries.begin();
+      const auto place     = std::upper_bound(old_first, std::next(old_first, old_end), *it, less);
+      dest                 = std::move_backward(place, std::next(old_first, old_end), dest);
+      *--dest              = *it;
+      old_end              = static_cast< size_t >(std::distance(old_first, place));
+    }
+  }
+
+  void _add_pending(size_t position) {
+    const auto entry = _entry_for(position);
+    _pending.insert(std::upper_bound(_pending.begin(),
+                                     _pending.end(),
+                                     entry,
+                                     [](auto&& lhs, auto&& rhs) { return _key_less(lhs.first, rhs.first); }),
+                    entry);
+  }
+
+  // Removes the entry for the item at the given position, from the index or the pending list. Everything after it
+  // moves down one place.
+  void _remove_from_index(size_t position) {
+    auto& entries = position < _index.size() ? _index : _pending;
+    entries.erase(_search(entries, _lookup_key(_values[position]->id())));
+
+    for (auto&& entry : _index) {
+      entry.second -= entry.second > position ? 1 : 0;
+    }
+
+    for (auto&& entry : _pending) {
+      entry.second -= entry.second > position ? 1 : 0;
+    }
+  }
+
+  // Searching in lock-step only pays off when the searches would otherwise stall on cache misses, which needs an index
+  // too big to stay in cache and a batch big enough to keep plenty of searches on the go. Otherwise plain binary
+  // searches, one ID at a time, are quicker.
+  static constexpr size_t _min_lock_step_batch_size  = 64;
+  static constexpr size_t _min_lock_step_index_bytes = size_t{8} << 20;
+
+  [[nodiscard]] bool _worth_searching_in_lock_step(size_t batch_size) const noexcept {
+    return batch_size >= _min_lock_step_batch_size and _index.size() * sizeof(_index_entry_type) >= _min_lock_step_index_bytes;
+  }
+
+  // Look up a batch in the index, a group of IDs at a time. All the searches in a group take the same number of steps,
+  // so they're run in lock-step, prefetching each search's next probe before moving on to the next search. IDs that
+  // aren't in the index are then looked for in the pending list.
+  template < typename Ptr_T >
+  void _find_many_indexed(std::span< const id_type > ids, std::span< Ptr_T > out) const {
+    constexpr auto group_size = size_t{16};
+
+    const auto entries = _index.data();
+
+    auto keys    = std::array< _index_key_type, group_size >{};
+    auto matches = std::array< const _index_entry_type*, group_size >{};
+
+    for (auto first = size_t{0}; first < ids.size(); first += group_size) {
+      const auto count = std::min(group_size, ids.size() - first);
+
+      for (auto g = size_t{0}; g < count; ++g) {
+        keys[g]    = _lookup_key(ids[first + g]);
+        matches[g] = _index.empty() ? nullptr : entries;
+      }
+
+      if (not _index.empty()) {
+        for (auto len = _index.size(); len > 1;) {
+          const auto half = len / 2;
+          len -= half;
+          for (auto g = size_t{0}; g < count; ++g) {
+            matches[g] += _key_less(matches[g][half - 1].first, keys[g]) ? half : 0;
+            detail::prefetch(matches[g] + len / 2);
+          }
+        }
+
+        for (auto g = size_t{0}; g < count; ++g) {
+          matches[g] += _key_less(matches[g]->first, keys[g]) ? 1 : 0;
+          if (entries + _index.size() != matches[g] and _key_equal(matches[g]->first, keys[g])) {
+            detail::prefetch(_values[matches[g]->second].get());
+          } else {
+            matches[g] = nullptr;
+          }
+        }
+      }
+
+      for (auto g = size_t{0}; g < count; ++g) {
+        if (nullptr != matches[g]) {
+          out[first + g] = _values[matches[g]->second].get();
+        } else if (const auto match = _search(_pending, keys[g]); _pending.end() != match) {
+          out[first + g] = _values[match->second].get();
+        }
+      }
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // Secondary indexes
+  //
+  ///////////////////////////////////////////////////////////////////////////////
+
+  template < typename Tag_T >
+  [[nodiscard]] static constexpr size_t _secondary_position() noexcept {
+    constexpr auto matches = std::array< bool, sizeof...(SecondaryIndex_Ts) >{
+        std::is_same_v< Tag_T, typename SecondaryIndex_Ts::tag_type >...};
+    static_assert(1 == std::count(matches.begin(), matches.end(), true),
+                  "There must be exactly one secondary index with this tag");
+
+    return static_cast< size_t >(std::distance(matches.begin(), std::find(matches.begin(), matches.end(), true)));
+  }
+
+  [[nodiscard]] value_type* _secondary_conflict(const value_type& val) const {
+    auto out = static_cast< value_type* >(nullptr);
+    std::apply([&](auto&... indexes) { ((out = nullptr != out ? out : indexes._conflict(val)), ...); }, _secondary_indexes);
+    return out;
+  }
+
+  void _insert_into_secondary_indexes(value_type* val) {
+    std::apply([val](auto&... indexes) { (indexes._insert(val), ...); }, _secondary_indexes);
+  }
+
+  void _erase_from_secondary_indexes(const value_type& val) {
+    std::apply([&val](auto&... indexes) { (indexes._erase(val), ...); }, _secondary_indexes);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //
+  // Compaction
+  //
+  ///////////////////////////////////////////////////////////////////////////////
+
+  [[nodiscard]] static bool _is_movable(const value_type& val) noexcept {
+    if constexpr (not std::is_move_constructible_v< value_type >) {
+      return false;
+    } else if constexpr (std::is_polymorphic_v< value_type >) {
+      return typeid(val) == typeid(value_type);
+    } else {
+      return true;
+    }
+  }
+
+  void _move_to_arena(size_t position) {
+    if constexpr (std::is_move_constructible_v< value_type >) {
+      auto& val = _values[position];
+      if (not _is_movable(*val)) {
+        return;
+      }
+
+      // The ID index refers to unpackable IDs by pointer, and the entry has to be found while the ID is still there.
+      auto index_entry = static_cast< _index_entry_type* >(nullptr);
+      if constexpr (not _has_packed_keys) {
+        if (_index_built.built()) {
+          auto& entries = position < _index.size() ? _index : _pending;
+          index_entry   = &*_search(entries, _lookup_key(val->id()));
+        }
+      }
+
+      const auto old   = val.get();
+      const auto moved = _compaction_arena->emplace(std::move(*val));
+      if constexpr (not _has_packed_keys) {
+        if (nullptr != index_entry) {
+          index_entry->first = &moved->id();
+        }
+      }
+
+      std::apply([&](auto&... indexes) { (indexes._relocate(old, moved), ...); }, _secondary_indexes);
+      val = _stored_type{moved, detail::item_deleter< value_type >{_compaction_arena.get()}};
+    }
+  }
+
+  // Items that are handed back to the caller have to be deletable by a plain std::unique_ptr.
+  [[nodiscard]] static _ptr_type _to_heap(_stored_type val) {
+    if (nullptr == val.get_deleter().arena) {
+      return _ptr_type{val.release()};
+    }
+
+    if constexpr (std::is_move_constructible_v< value_type >) {
+      return std::make_unique< value_type >(std::move(*val));
+    } else {
+      assert(false and "Only move-constructible items are ever moved into an arena");
+      return nullptr;
+    }
+  }
+
+  value_type* _unchecked_add(_stored_type&& val) {
+    if constexpr (_has_packed_keys) {
+      _keys.push_back(pack_key(val->id()));
+    }
+
+    _values.push_back(std::move(val));
+    _insert_into_secondary_indexes(_values.back().get());
     return _values.back().get();
   }
 
   _container_type _values;
+  detail::key_storage_t< id_type > _keys;
+  std::vector< _index_entry_type > _index;
+  std::vector< _index_entry_type > _pending;
+  detail::build_once _index_built;
+  std::tuple< secondary_index< value_type, SecondaryIndex_Ts >... > _secondary_indexes;
+
+  // While a compaction is under way: the block the items are moving into, and the range of positions still to move.
+  detail::arena_filler< value_type > _compaction_arena;
+  size_t _compaction_next{0};
+  size_t _compaction_end{0};
 };
 
 ///////////////////////////////////////////////////////////////////////////////
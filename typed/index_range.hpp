@@ -0,0 +1,125 @@
+#pragma once
+
+#include <typed/index.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// The half-open range of indices [first, last) of one type of collection. Iterating over it gives typed indices, so a
+/// range of one collection's indices can't be used to get items out of a different type of collection. A range can be
+/// split into pieces, which is how parallel_for (see parallel.hpp) shares out a collection between threads.
+/// </summary>
+template < typename Index_T >
+class index_range {
+ public:
+  using index_type = Index_T;
+  using size_type  = typename index_type::value_type;
+
+  class iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = index_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const index_type*;
+    using reference         = index_type;
+
+    constexpr iterator() noexcept = default;
+    constexpr explicit iterator(index_type idx) noexcept : _idx{idx} {}
+
+    [[nodiscard]] constexpr index_type operator*() const noexcept { return _idx; }
+    [[nodiscard]] constexpr index_type operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    constexpr iterator& operator++() noexcept {
+      ++_idx;
+      return *this;
+    }
+
+    constexpr iterator operator++(int) noexcept { return iterator{_idx++}; }
+
+    constexpr iterator& operator--() noexcept {
+      --_idx;
+      return *this;
+    }
+
+    constexpr iterator operator--(int) noexcept { return iterator{_idx--}; }
+
+    constexpr iterator& operator+=(difference_type n) noexcept {
+      _idx = index_type{static_cast< size_type >(static_cast< difference_type >(_idx.get()) + n)};
+      return *this;
+    }
+
+    constexpr iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+
+    [[nodiscard]] friend constexpr iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+    [[nodiscard]] friend constexpr iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+    [[nodiscard]] friend constexpr iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+
+    [[nodiscard]] friend constexpr difference_type operator-(const iterator& lhs, const iterator& rhs) noexcept {
+      return static_cast< difference_type >(lhs._idx.get()) - static_cast< difference_type >(rhs._idx.get());
+    }
+
+    [[nodiscard]] auto operator<=>(const iterator&) const = default;
+
+   private:
+    index_type _idx{};
+  };
+
+  constexpr index_range() noexcept = default;
+
+  constexpr index_range(index_type first, index_type last) noexcept : _first{first}, _last{std::max(first, last)} {}
+
+  [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{_first}; }
+  [[nodiscard]] constexpr iterator end() const noexcept { return iterator{_last}; }
+
+  [[nodiscard]] constexpr index_type front() const noexcept { return _first; }
+  [[nodiscard]] constexpr index_type back() const noexcept { return _last - size_type{1}; }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return (_last - _first).get(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return _first == _last; }
+
+  /// <summary>
+  /// Splits off the first count indices (or all of them, if there are fewer): returns those, and leaves the rest.
+  /// </summary>
+  [[nodiscard]] constexpr index_range take_front(size_type count) noexcept {
+    const auto middle = _first + std::min(count, size());
+    return index_range{std::exchange(_first, middle), middle};
+  }
+
+  /// <summary>
+  /// Splits the range in two: returns the second half, and leaves the first.
+  /// </summary>
+  [[nodiscard]] constexpr index_range split() noexcept {
+    const auto middle = _first + static_cast< size_type >(size() / 2);
+    return index_range{middle, std::exchange(_last, middle)};
+  }
+
+  [[nodiscard]] constexpr bool operator==(const index_range&) const noexcept = default;
+
+ private:
+  index_type _first{};
+  index_type _last{};
+};
+
+/// <summary>
+/// All the indices of a collection.
+/// </summary>
+template < typename Collection_T >
+[[nodiscard]] constexpr auto indices(const Collection_T& collection) noexcept {
+  using index_type = typename Collection_T::index_type;
+  return index_range< index_type >{index_type{0}, index_type{collection.size().get()}};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
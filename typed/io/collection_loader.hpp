@@ -0,0 +1,360 @@
+#pragma once
+
+#include <typed/detail/bounded_queue.hpp>
+#include <typed/detail/collection_access.hpp>
+#include <typed/io/idio.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// A snapshot of how far through a load a collection_loader has got. A record is rejected if the parser doesn't
+/// produce an item for it, or if its item has the same ID as an item from an earlier record (or clashes with one in a
+/// unique secondary index). Duplicates are all found in one go once the stream has been read, so until the load is
+/// done, inserted counts items that may yet turn out to be duplicates.
+/// </summary>
+struct load_progress {
+  size_t read{0};
+  size_t parsed{0};
+  size_t inserted{0};
+  size_t rejected{0};
+  bool done{false};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Fills a collection from a stream of newline-separated records, using a pipeline of threads: one reads lines from
+/// the stream, several parse them into items, and one gathers the items up in stream order. The stages are connected
+/// by bounded queues, and parsers that get too far ahead of the slowest one wait for it, so reading and parsing overlap
+/// and memory use stays bounded. Gathering an item is just moving a pointer: items with duplicate IDs are dropped in a
+/// single sort once the stream has been read, and the collection then takes over the gathered items in one go. Items
+/// end up in the collection in the same order as their records appear in the stream, whatever order they get parsed
+/// in, and where two records have the same ID, the earlier one wins.
+///
+/// The parser turns a single (non-empty) record into an item, or returns nullptr to reject it. It's called from several
+/// threads at once, so it has to be safe to call concurrently. By default, the whole record is read as an ID (using the
+/// stream operators in idio.hpp) and the item is constructed from that ID; a record with anything but whitespace left
+/// over after the ID is rejected.
+///
+/// The collection's ID index is left to be built lazily, as usual; call build_index on the collection to build it up
+/// front.
+/// </summary>
+template < typename Collection_T >
+class collection_loader {
+ public:
+  using collection_type = Collection_T;
+  using value_type      = typename collection_type::value_type;
+  using id_type         = typename collection_type::id_type;
+  using parser_type     = std::function< std::unique_ptr< value_type >(std::string_view) >;
+
+  static constexpr size_t default_batch_size     = 256;
+  static constexpr size_t default_queue_capacity = 16;
+
+  collection_loader() requires std::constructible_from< value_type, id_type > : collection_loader{&parse_id} {}
+
+  explicit collection_loader(parser_type parser,
+                             size_t parser_count   = default_parser_count(),
+                             size_t queue_capacity = default_queue_capacity,
+                             size_t batch_size     = default_batch_size)
+      : _parser{std::move(parser)}
+      , _parser_count{std::max< size_t >(parser_count, 1)}
+      , _queue_capacity{queue_capacity}
+      , _batch_size{std::max< size_t >(batch_size, 1)}
+      , _progress{std::make_shared< _progress_type >()} {}
+
+  /// <summary>
+  /// Starts loading from the stream in the background. The stream must stay alive until the returned future is ready,
+  /// and a loader should only run one load at a time. If reading or parsing throws, the pipeline is stopped and the
+  /// exception comes out of the future.
+  /// </summary>
+  [[nodiscard]] std::future< collection_type > load(std::istream& in) {
+    _progress->reset();
+
+    return std::async(std::launch::async,
+                      [&in, parser = _parser, progress = _progress, parsers = _parser_count, capacity = _queue_capacity,
+                       batch_size = _batch_size] { return _run(in, parser, *progress, parsers, capacity, batch_size); });
+  }
+
+  [[nodiscard]] load_progress progress() const noexcept { return _progress->snapshot(); }
+
+  [[nodiscard]] static std::unique_ptr< value_type > parse_id(std::string_view record) requires
+      std::constructible_from< value_type, id_type > {
+    auto in = std::istringstream{std::string{record}};
+    auto id = id_type{};
+    if (not(in >> id) or not(in >> std::ws).eof()) {
+      return nullptr;
+    }
+
+    return std::make_unique< value_type >(std::move(id));
+  }
+
+  [[nodiscard]] static size_t default_parser_count() noexcept {
+    return std::max< size_t >(std::thread::hardware_concurrency(), 2) - 1;
+  }
+
+ private:
+  struct _progress_type {
+    std::atomic< size_t > read{0};
+    std::atomic< size_t > parsed{0};
+    std::atomic< size_t > inserted{0};
+    std::atomic< size_t > rejected{0};
+    std::atomic< bool > done{false};
+
+    void reset() noexcept {
+      read     = 0;
+      parsed   = 0;
+      inserted = 0;
+      rejected = 0;
+      done     = false;
+    }
+
+    load_progress snapshot() const noexcept { return {read, parsed, inserted, rejected, done}; }
+  };
+
+  template < typename T >
+  struct _batch {
+    size_t sequence;
+    std::vector< T > values;
+  };
+
+  using _record_batch   = _batch< std::string >;
+  using _item_batch     = _batch< std::unique_ptr< value_type > >;
+  using _container_type = detail::collection_access::container_t< collection_type >;
+
+  // Keeps the parsers from getting more than a set number of batches ahead of the oldest batch that hasn't been
+  // gathered yet, so that one slow parser can't make the batches that follow it pile up without limit.
+  class _window {
+   public:
+    explicit _window(size_t width) : _width{std::max< size_t >(width, 1)} {}
+
+    // Returns false if the window was closed while waiting.
+    bool wait_for(size_t sequence) {
+      auto lock = std::unique_lock{_mutex};
+      _moved.wait(lock, [&] { return _closed or sequence < _next + _width; });
+      return not _closed;
+    }
+
+    void advance_to(size_t next) {
+      {
+        auto lock = std::lock_guard{_mutex};
+        _next     = next;
+      }
+      _moved.notify_all();
+    }
+
+    void close() {
+      {
+        auto lock = std::lock_guard{_mutex};
+        _closed   = true;
+      }
+      _moved.notify_all();
+    }
+
+   private:
+    const size_t _width;
+    std::mutex _mutex;
+    std::condition_variable _moved;
+    size_t _next{0};
+    bool _closed{false};
+  };
+
+  // Drops every item with the same ID as an item before it, keeping the rest in order.
+  static void _drop_duplicates(_container_type& values) {
+    auto by_id = std::vector< std::pair< const id_type*, size_t > >{};
+    by_id.reserve(values.size());
+    for (auto i = size_t{0}; i < values.size(); ++i) {
+      by_id.emplace_back(&values[i]->id(), i);
+    }
+
+    std::sort(by_id.begin(), by_id.end(), [](auto&& lhs, auto&& rhs) {
+      return *lhs.first < *rhs.first or (*lhs.first == *rhs.first and lhs.second < rhs.second);
+    });
+
+    auto keep = std::vector< char >(values.size(), char{1});
+    for (auto i = size_t{1}; i < by_id.size(); ++i) {
+      if (*by_id[i - 1].first == *by_id[i].first) {
+        keep[by_id[i].second] = char{0};
+      }
+    }
+
+    auto kept = size_t{0};
+    for (auto i = size_t{0}; i < values.size(); ++i) {
+      if (keep[i]) {
+        std::swap(values[kept++], values[i]);
+      }
+    }
+
+    values.resize(kept);
+  }
+
+  static collection_type _run(std::istream& in,
+                              const parser_type& parser,
+                              _progress_type& progress,
+                              size_t parser_count,
+                              size_t queue_capacity,
+                              size_t batch_size) {
+    auto records = detail::bounded_queue< _record_batch >{queue_capacity};
+    auto items   = detail::bounded_queue< _item_batch >{queue_capacity};
+    auto window  = _window{queue_capacity};
+
+    auto error       = std::exception_ptr{};
+    auto error_mutex = std::mutex{};
+    auto fail        = [&](std::exception_ptr e) {
+      {
+        auto lock = std::lock_guard{error_mutex};
+        if (not error) {
+          error = std::move(e);
+        }
+      }
+
+      records.close();
+      items.close();
+      window.close();
+    };
+
+    auto reader = std::jthread{[&] {
+      try {
+        auto sequence = size_t{0};
+        auto batch    = _record_batch{sequence++, {}};
+        for (auto line = std::string{}; std::getline(in, line);) {
+          if (line.empty()) {
+            continue;
+          }
+
+          batch.values.push_back(std::move(line));
+          ++progress.read;
+
+          if (batch.values.size() == batch_size) {
+            if (not records.push(std::exchange(batch, _record_batch{sequence++, {}}))) {
+              return;
+            }
+          }
+        }
+
+        records.push(std::move(batch));
+      } catch (...) {
+        fail(std::current_exception());
+      }
+
+      records.close();
+    }};
+
+    auto running_parsers = std::atomic< size_t >{parser_count};
+    auto parsers         = std::vector< std::jthread >{};
+    for (auto i = size_t{0}; i < parser_count; ++i) {
+      parsers.emplace_back([&] {
+        try {
+          while (auto batch = records.pop()) {
+            auto parsed = _item_batch{batch->sequence, {}};
+            parsed.values.reserve(batch->values.size());
+            for (auto&& record : batch->values) {
+              parsed.values.push_back(parser(record));
+              ++progress.parsed;
+            }
+
+            if (not window.wait_for(parsed.sequence) or not items.push(std::move(parsed))) {
+              break;
+            }
+          }
+        } catch (...) {
+          fail(std::current_exception());
+        }
+
+        if (0 == --running_parsers) {
+          items.close();
+        }
+      });
+    }
+
+    auto values = _container_type{};
+    try {
+      // Batches can come out of the parsers in any order, so hold on to the early ones until it's their turn.
+      auto pending = std::map< size_t, std::vector< std::unique_ptr< value_type > > >{};
+      auto next    = size_t{0};
+      while (auto batch = items.pop()) {
+        pending.emplace(batch->sequence, std::move(batch->values));
+
+        const auto first = next;
+        for (auto it = pending.begin(); pending.end() != it and next == it->first; it = pending.erase(it), ++next) {
+          for (auto&& item : it->second) {
+            if (nullptr != item) {
+              values.push_back(std::move(item));
+              ++progress.inserted;
+            } else {
+              ++progress.rejected;
+            }
+          }
+        }
+
+        if (first != next) {
+          window.advance_to(next);
+        }
+      }
+    } catch (...) {
+      fail(std::current_exception());
+    }
+
+    reader.join();
+    for (auto&& parser_thread : parsers) {
+      parser_thread.join();
+    }
+
+    auto out = collection_type{};
+    if (not error) {
+      try {
+        const auto gathered = values.size();
+        _drop_duplicates(values);
+        out = detail::collection_access::adopt< collection_type >(std::move(values));
+
+        const auto dropped = gathered - static_cast< size_t >(out.size().get());
+        progress.inserted -= dropped;
+        progress.rejected += dropped;
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    progress.done = true;
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+
+    return out;
+  }
+
+  parser_type _parser;
+  size_t _parser_count;
+  size_t _queue_capacity;
+  size_t _batch_size;
+  std::shared_ptr< _progress_type > _progress;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
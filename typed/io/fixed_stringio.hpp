@@ -0,0 +1,43 @@
+#pragma once
+
+#include <typed/fixed_string.hpp>
+
+#include <iostream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+template < size_t N >
+std::ostream& operator<<(std::ostream& os, const fixed_string< N >& x) {
+  os << x.view();
+
+  return os;
+}
+
+/// <summary>
+/// Reads a whitespace-delimited word, like reading a std::string. If the word is too long, or has a '\0' in it, the
+/// stream's failbit is set and x is left alone.
+/// </summary>
+template < size_t N >
+std::istream& operator>>(std::istream& is, fixed_string< N >& x) {
+  auto value = std::string{};
+  if (is >> value) {
+    if (value.size() > N or std::string::npos != value.find('\0')) {
+      is.setstate(std::ios_base::failbit);
+    } else {
+      x = fixed_string< N >{value};
+    }
+  }
+
+  return is;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
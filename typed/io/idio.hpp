@@ -17,6 +17,16 @@ std::ostream& operator<<(std::ostream& os, const id< Id_T, Value_T >& x) {
   return os;
 }
 
+template < typename Id_T, typename Value_T >
+std::istream& operator>>(std::istream& is, id< Id_T, Value_T >& x) {
+  auto value = Value_T{};
+  if (is >> value) {
+    x = id< Id_T, Value_T >{std::move(value)};
+  }
+
+  return is;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }  // namespace typed
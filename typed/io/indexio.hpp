@@ -17,6 +17,16 @@ std::ostream& operator<<(std::ostream& os, const index< Id_T, Value_T >& x) {
   return os;
 }
 
+template < typename Id_T, typename Value_T >
+std::istream& operator>>(std::istream& is, index< Id_T, Value_T >& x) {
+  auto value = Value_T{};
+  if (is >> value) {
+    x = index< Id_T, Value_T >{std::move(value)};
+  }
+
+  return is;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }  // namespace typed
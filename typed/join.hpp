@@ -0,0 +1,340 @@
+#pragma once
+
+#include <typed/detail/radix_sort.hpp>
+#include <typed/key_traits.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class join_strategy {
+  automatic,
+  hash,
+  sort_merge,
+};
+
+namespace detail {
+
+template < typename T >
+constexpr bool is_hashable_key = packable_key< T > or std::is_default_constructible_v< std::hash< T > >;
+
+template < typename Id_T, typename Value_T >
+constexpr bool is_hashable_key< id< Id_T, Value_T > > = packable_key< id< Id_T, Value_T > > or is_hashable_key< Value_T >;
+
+// A projection either gives a single ID of the target collection, or a range of them.
+template < typename Item_T, typename Projection_T >
+using projected_t = std::remove_cvref_t< std::invoke_result_t< Projection_T, const Item_T& > >;
+
+template < typename Projected_T, typename Id_T >
+concept single_reference = std::same_as< Projected_T, Id_T >;
+
+template < typename Projected_T, typename Id_T >
+concept many_references = std::ranges::input_range< const Projected_T > and
+                          std::same_as< std::remove_cvref_t< std::ranges::range_reference_t< const Projected_T > >, Id_T >;
+
+template < typename Item_T, typename Projection_T, typename Id_T >
+concept projects_references = std::invocable< Projection_T, const Item_T& > and
+                              (single_reference< projected_t< Item_T, Projection_T >, Id_T > or
+                               many_references< projected_t< Item_T, Projection_T >, Id_T >);
+
+}  // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// The result of a join: for each item of the source collection, the items of the target collection that its references
+/// resolved to, indexed by the source collection's own index type. For a projection that gives a single ID, each entry is
+/// a pointer to the target item (or nullptr, if there's no item with that ID); for one that gives a range of IDs, each
+/// entry is a span of pointers, one for each reference, in the same order.
+/// </summary>
+template < typename Source_T, typename Target_T, bool Many_T >
+class join_result {
+ public:
+  using source_index_type = typename Source_T::index_type;
+  using target_value_type = const typename Target_T::value_type;
+  using mapped_type       = std::conditional_t< Many_T, std::span< target_value_type* const >, target_value_type* >;
+
+  /// <summary>
+  /// Takes the resolved target of each reference (or nullptr), in source order. For a range projection, the references
+  /// of source item i are the ones in [offsets[i], offsets[i + 1]).
+  /// </summary>
+  join_result(std::vector< target_value_type* > targets, std::vector< size_t > offsets = {})
+      : _targets{std::move(targets)}
+      , _offsets{std::move(offsets)}
+      , _unresolved{static_cast< size_t >(std::count(_targets.begin(), _targets.end(), nullptr))} {
+    assert(not Many_T or (not _offsets.empty() and _targets.size() == _offsets.back()));
+  }
+
+  [[nodiscard]] typename Source_T::size_type size() const noexcept {
+    return typename Source_T::size_type{static_cast< typename Source_T::size_type::value_type >(_source_count())};
+  }
+
+  [[nodiscard]] mapped_type operator[](const source_index_type& idx) const {
+    if constexpr (Many_T) {
+      const auto first = _offsets[idx.get()];
+      return {_targets.data() + first, _offsets[idx.get() + 1] - first};
+    } else {
+      return _targets[idx.get()];
+    }
+  }
+
+  /// <summary>
+  /// How many references didn't match any item in the target collection.
+  /// </summary>
+  [[nodiscard]] size_t unresolved() const noexcept { return _unresolved; }
+
+ private:
+  [[nodiscard]] size_t _source_count() const noexcept {
+    if constexpr (Many_T) {
+      return _offsets.size() - 1;
+    } else {
+      return _targets.size();
+    }
+  }
+
+  std::vector< target_value_type* > _targets;
+  std::vector< size_t > _offsets;
+  size_t _unresolved;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// With packed keys, both sides can be radix sorted in linear time and then merged with sequential access, which beats
+// the random access of a hash table. But if one side is this many times smaller than the other, hashing the small side
+// and streaming the big one past it saves sorting the big side.
+constexpr size_t min_hash_join_size_ratio = 16;
+
+template < typename Target_C >
+[[nodiscard]] join_strategy choose_join_strategy(size_t reference_count, size_t target_count) noexcept {
+  using id_type = typename Target_C::id_type;
+
+  if constexpr (not is_hashable_key< id_type >) {
+    return join_strategy::sort_merge;
+  } else if constexpr (packable_key< id_type >) {
+    const auto [smaller, larger] = std::minmax(reference_count, target_count);
+    return larger / smaller >= min_hash_join_size_ratio ? join_strategy::hash : join_strategy::sort_merge;
+  } else {
+    return join_strategy::hash;
+  }
+}
+
+// Builds a hash table on whichever of the two sides is smaller, and streams the other side past it.
+template < typename Target_C, typename Target_Ptr >
+void hash_join(std::span< const typename Target_C::id_type* const > references,
+               const Target_C& target,
+               std::span< Target_Ptr > out) {
+  using id_type    = typename Target_C::id_type;
+  using index_type = typename Target_C::index_type;
+
+  if (target.size().get() <= references.size()) {
+    auto table = std::unordered_map< id_type, Target_Ptr, key_hash< id_type > >{};
+    table.reserve(target.size().get());
+    for (auto i = index_type{0}; i < target.size(); ++i) {
+      table.emplace(target.at(i).id(), &target.at(i));
+    }
+
+    std::transform(references.begin(), references.end(), out.begin(), [&table](auto ref) -> Target_Ptr {
+      const auto match = table.find(*ref);
+      return table.end() != match ? match->second : nullptr;
+    });
+  } else {
+    // Several references can be to the same ID, so each distinct ID maps to the first of its slots, and the slots for
+    // each ID are chained together through next.
+    constexpr auto none = ~size_t{0};
+
+    auto table = std::unordered_map< id_type, size_t, key_hash< id_type > >{};
+    auto next  = std::vector< size_t >(references.size(), none);
+    table.reserve(references.size());
+    for (auto slot = size_t{0}; slot < references.size(); ++slot) {
+      const auto [match, added] = table.try_emplace(*references[slot], slot);
+      if (not added) {
+        next[slot] = std::exchange(match->second, slot);
+      }
+    }
+
+    for (auto i = index_type{0}; i < target.size() and not table.empty(); ++i) {
+      const auto match = table.find(target.at(i).id());
+      if (table.end() == match) {
+        continue;
+      }
+
+      for (auto slot = match->second; none != slot; slot = next[slot]) {
+        out[slot] = &target.at(i);
+      }
+
+      table.erase(match);
+    }
+  }
+}
+
+// Sorts the references and the target's IDs and walks through both together. Packable IDs are sorted with a radix sort
+// on their packed keys.
+template < typename Target_C, typename Target_Ptr >
+void sort_merge_join(std::span< const typename Target_C::id_type* const > references,
+                     const Target_C& target,
+                     std::span< Target_Ptr > out) {
+  using id_type    = typename Target_C::id_type;
+  using index_type = typename Target_C::index_type;
+
+  const auto merge = [&](auto&& refs, auto&& items, auto&& less) {
+    auto item = items.begin();
+    for (auto&& [key, slot] : refs) {
+      while (items.end() != item and less(item->first, key)) {
+        ++item;
+      }
+
+      if (items.end() != item and not less(key, item->first)) {
+        out[slot] = item->second;
+      }
+    }
+  };
+
+  if constexpr (packable_key< id_type >) {
+    auto refs = std::vector< std::pair< packed_key_t< id_type >, size_t > >(references.size());
+    for (auto slot = size_t{0}; slot < references.size(); ++slot) {
+      refs[slot] = {pack_key(*references[slot]), slot};
+    }
+
+    auto items = std::vector< std::pair< packed_key_t< id_type >, Target_Ptr > >{};
+    items.reserve(target.size().get());
+    for (auto i = index_type{0}; i < target.size(); ++i) {
+      items.emplace_back(pack_key(target.at(i).id()), &target.at(i));
+    }
+
+    detail::radix_sort(refs);
+    detail::radix_sort(items);
+    merge(refs, items, std::less<>{});
+  } else {
+    auto refs = std::vector< std::pair< const id_type*, size_t > >(references.size());
+    for (auto slot = size_t{0}; slot < references.size(); ++slot) {
+      refs[slot] = {references[slot], slot};
+    }
+
+    auto items = std::vector< std::pair< const id_type*, Target_Ptr > >{};
+    items.reserve(target.size().get());
+    for (auto i = index_type{0}; i < target.size(); ++i) {
+      items.emplace_back(&target.at(i).id(), &target.at(i));
+    }
+
+    const auto less = [](auto lhs, auto rhs) { return *lhs < *rhs; };
+    std::sort(refs.begin(), refs.end(), [&](auto&& lhs, auto&& rhs) { return less(lhs.first, rhs.first); });
+    std::sort(items.begin(), items.end(), [&](auto&& lhs, auto&& rhs) { return less(lhs.first, rhs.first); });
+    merge(refs, items, less);
+  }
+}
+
+}  // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Resolves the references that the items of one collection hold to the items of another, all in one go rather than
+/// with a find for each reference. The projection (e.g. a pointer to a data member or member function) gets the ID, or
+/// a range of IDs, from a source item, and these must be IDs of the target collection's item type, so that joining on
+/// the wrong type of ID doesn't compile.
+///
+/// The join is done either by hashing the smaller side and streaming the other past it, or by sorting both sides and
+/// merging them. By default, IDs with packed keys are sort-merge joined, since they can be radix sorted, unless one side
+/// is much smaller than the other; other IDs are hash joined if they can be hashed. The strategy argument overrides that
+/// choice, except that IDs that can't be hashed are always sort-merge joined.
+/// </summary>
+template < typename Source_C, typename Projection_T, typename Target_C >
+requires detail::projects_references< typename Source_C::value_type, Projection_T, typename Target_C::id_type >
+[[nodiscard]] auto join(const Source_C& source,
+                        Projection_T&& projection,
+                        const Target_C& target,
+                        join_strategy strategy = join_strategy::automatic) {
+  using id_type        = typename Target_C::id_type;
+  using projected_type = detail::projected_t< typename Source_C::value_type, Projection_T >;
+
+  constexpr auto many = not detail::single_reference< projected_type, id_type >;
+
+  using result_type = join_result< Source_C, Target_C, many >;
+  using target_ptr  = typename result_type::target_value_type*;
+
+  // If the projection gives its IDs by value, they have to be copied somewhere that doesn't move, so that they can be
+  // pointed at.
+  constexpr auto copy_references = [] {
+    if constexpr (many) {
+      return not std::is_lvalue_reference_v< std::invoke_result_t< Projection_T, const typename Source_C::value_type& > > or
+             not std::is_lvalue_reference_v< std::ranges::range_reference_t< const projected_type > >;
+    } else {
+      return not std::is_lvalue_reference_v< std::invoke_result_t< Projection_T, const typename Source_C::value_type& > >;
+    }
+  }();
+
+  auto copies     = std::deque< id_type >{};
+  auto references = std::vector< const id_type* >{};
+  auto offsets    = std::vector< size_t >{};
+  references.reserve(source.size().get());
+
+  const auto add_reference = [&](auto&& ref) {
+    if constexpr (copy_references) {
+      references.push_back(&copies.emplace_back(ref));
+    } else {
+      references.push_back(&ref);
+    }
+  };
+
+  if constexpr (many) {
+    offsets.reserve(source.size().get() + 1);
+    offsets.push_back(0);
+  }
+
+  for (auto i = typename Source_C::index_type{0}; i < source.size(); ++i) {
+    auto&& projected = std::invoke(projection, source.at(i));
+    if constexpr (many) {
+      for (auto&& ref : projected) {
+        add_reference(ref);
+      }
+
+      offsets.push_back(references.size());
+    } else {
+      add_reference(projected);
+    }
+  }
+
+  auto targets = std::vector< target_ptr >(references.size(), nullptr);
+  if (not references.empty() and 0 != target.size().get()) {
+    if (join_strategy::automatic == strategy) {
+      strategy = detail::choose_join_strategy< Target_C >(references.size(), target.size().get());
+    }
+
+    const auto refs = std::span< const id_type* const >{references};
+    const auto out  = std::span< target_ptr >{targets};
+    if constexpr (detail::is_hashable_key< id_type >) {
+      if (join_strategy::hash == strategy) {
+        detail::hash_join(refs, target, out);
+      } else {
+        detail::sort_merge_join(refs, target, out);
+      }
+    } else {
+      detail::sort_merge_join(refs, target, out);
+    }
+  }
+
+  return result_type{std::move(targets), std::move(offsets)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
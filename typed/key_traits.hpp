@@ -0,0 +1,117 @@
+#pragma once
+
+#include <typed/id.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// Specialise this to say that values of a type can be packed into a single unsigned integer that sorts in the same
+/// order as the values themselves. A specialisation needs a key_type alias, for the unsigned integer type, and a static
+/// pack(const T&) function, such that pack(a) < pack(b) exactly when a < b and pack(a) == pack(b) exactly when a == b.
+///
+/// IDs with a packable value type get sorted with a radix sort, hashed with a single integer hash and searched by
+/// scanning a flat array of keys, rather than going through the value type's own comparison operators.
+/// </summary>
+template < typename T >
+struct key_traits {};
+
+template < typename T >
+concept packable_key = requires(const T& value) {
+  typename key_traits< T >::key_type;
+  { key_traits< T >::pack(value) } -> std::same_as< typename key_traits< T >::key_type >;
+} and std::unsigned_integral< typename key_traits< T >::key_type > and
+    not std::same_as< typename key_traits< T >::key_type, bool >;
+
+template < packable_key T >
+using packed_key_t = typename key_traits< T >::key_type;
+
+template < packable_key T >
+[[nodiscard]] constexpr packed_key_t< T > pack_key(const T& value) noexcept {
+  return key_traits< T >::pack(value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template < std::unsigned_integral T >
+requires(not std::same_as< T, bool >) struct key_traits< T > {
+  using key_type = T;
+
+  [[nodiscard]] static constexpr key_type pack(T value) noexcept { return value; }
+};
+
+template < std::signed_integral T >
+struct key_traits< T > {
+  using key_type = std::make_unsigned_t< T >;
+
+  // Flipping the sign bit moves the negative numbers below the positive ones.
+  [[nodiscard]] static constexpr key_type pack(T value) noexcept {
+    return static_cast< key_type >(value) ^ (key_type{1} << (std::numeric_limits< key_type >::digits - 1));
+  }
+};
+
+template < typename T >
+requires std::is_enum_v< T > and packable_key< std::underlying_type_t< T > >
+struct key_traits< T > {
+  using key_type = packed_key_t< std::underlying_type_t< T > >;
+
+  [[nodiscard]] static constexpr key_type pack(T value) noexcept {
+    return pack_key(static_cast< std::underlying_type_t< T > >(value));
+  }
+};
+
+template < typename Id_T, packable_key Value_T >
+struct key_traits< id< Id_T, Value_T > > {
+  using key_type = packed_key_t< Value_T >;
+
+  [[nodiscard]] static constexpr key_type pack(const id< Id_T, Value_T >& value) noexcept { return pack_key(value.get()); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// The finaliser from SplitMix64, so that keys that only differ in a few bits still spread over all the buckets.
+[[nodiscard]] constexpr std::uint64_t mix_bits(std::uint64_t x) noexcept {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+}  // namespace detail
+
+/// <summary>
+/// A hash for use in unordered containers. Packable types are hashed by mixing the bits of their packed key, everything
+/// else falls back to std::hash (of the underlying value, for IDs).
+/// </summary>
+template < typename T >
+struct key_hash {
+  [[nodiscard]] size_t operator()(const T& value) const noexcept {
+    if constexpr (packable_key< T >) {
+      return static_cast< size_t >(detail::mix_bits(static_cast< std::uint64_t >(pack_key(value))));
+    } else {
+      return std::hash< T >{}(value);
+    }
+  }
+};
+
+template < typename Id_T, typename Value_T >
+requires(not packable_key< id< Id_T, Value_T > >) struct key_hash< id< Id_T, Value_T > > {
+  [[nodiscard]] size_t operator()(const id< Id_T, Value_T >& value) const noexcept { return key_hash< Value_T >{}(value.get()); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <typed/detail/collection_access.hpp>
+#include <typed/detail/radix_sort.hpp>
+#include <typed/key_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+template < typename Collection_T >
+[[nodiscard]] bool is_sorted_by_id(const Collection_T& collection) {
+  for (auto i = typename Collection_T::index_type{1}; i < collection.size(); ++i) {
+    if (not(collection.at(i - 1).id() < collection.at(i).id())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// <summary>
+/// Reorders the items of a collection so that their IDs are in ascending order. IDs with a packable value type (see
+/// key_traits.hpp) are sorted with an LSD radix sort over their packed keys; anything else is sorted by comparison.
+/// Indices into the collection from before the sort don't refer to the same items afterwards, but pointers do.
+/// </summary>
+template < typename Collection_T >
+void sort_by_id(Collection_T& collection) {
+  using id_type = typename Collection_T::id_type;
+
+  auto values = detail::collection_access::release(collection);
+
+  if constexpr (packable_key< id_type >) {
+    auto keyed = std::vector< std::pair< packed_key_t< id_type >, typename decltype(values)::value_type > >{};
+    keyed.reserve(values.size());
+    for (auto&& value : values) {
+      const auto key = pack_key(value->id());
+      keyed.emplace_back(key, std::move(value));
+    }
+
+    detail::radix_sort(keyed);
+
+    std::transform(keyed.begin(), keyed.end(), values.begin(), [](auto&& entry) { return std::move(entry.second); });
+  } else {
+    std::sort(values.begin(), values.end(), [](auto&& lhs, auto&& rhs) { return lhs->id() < rhs->id(); });
+  }
+
+  collection = detail::collection_access::adopt< Collection_T >(std::move(values));
+}
+
+/// <summary>
+/// Merges two collections that are both already sorted by ID (see sort_by_id) into one that is also sorted by ID. If
+/// both collections have an item with the same ID, the one from the first collection is kept and the other is dropped.
+/// Items that clash in a unique secondary index are treated like the collection's add would: the one that comes first
+/// in the merged order is kept.
+/// </summary>
+template < typename Collection_T >
+[[nodiscard]] Collection_T merge_by_id(Collection_T first, Collection_T second) {
+  using id_type = typename Collection_T::id_type;
+
+  auto lhs = detail::collection_access::release(first);
+  auto rhs = detail::collection_access::release(second);
+
+  const auto less = [](auto&& l, auto&& r) {
+    if constexpr (packable_key< id_type >) {
+      return pack_key(l->id()) < pack_key(r->id());
+    } else {
+      return l->id() < r->id();
+    }
+  };
+
+  auto out = decltype(lhs){};
+  out.reserve(lhs.size() + rhs.size());
+
+  auto l = lhs.begin();
+  auto r = rhs.begin();
+  while (lhs.end() != l and rhs.end() != r) {
+    if (less(*r, *l)) {
+      out.push_back(std::move(*r++));
+    } else {
+      if (not less(*l, *r)) {
+        ++r;
+      }
+
+      out.push_back(std::move(*l++));
+    }
+  }
+
+  std::move(l, lhs.end(), std::back_inserter(out));
+  std::move(r, rhs.end(), std::back_inserter(out));
+
+  return detail::collection_access::adopt< Collection_T >(std::move(out));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <typed/detail/work_stealing_pool.hpp>
+#include <typed/index_range.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// The pool of threads that parallel_for and parallel_reduce run on (see detail/work_stealing_pool.hpp). The overloads
+/// that don't take one use parallel_pool::shared(), which has a thread for each hardware thread; make one of your own
+/// to run on fewer (or more) threads.
+/// </summary>
+using parallel_pool = detail::work_stealing_pool;
+
+/// <summary>
+/// Calls fn(idx) for every index in the range, in parallel, on the pool. Indices are handed out in chunks of
+/// consecutive indices, which are split up as needed to keep all the threads busy; grain_size caps the size of a chunk
+/// (zero picks one). Returns when every call has returned. If any call throws, the rest of the range may be skipped,
+/// and the first exception is rethrown.
+/// </summary>
+template < typename Index_T, typename Fn_T >
+void parallel_for(parallel_pool& pool, const index_range< Index_T >& range, Fn_T&& fn, size_t grain_size = 0) {
+  pool.run(range, grain_size, [&fn](size_t, const index_range< Index_T >& chunk) {
+    for (auto idx : chunk) {
+      fn(idx);
+    }
+  });
+}
+
+template < typename Index_T, typename Fn_T >
+void parallel_for(const index_range< Index_T >& range, Fn_T&& fn, size_t grain_size = 0) {
+  parallel_for(parallel_pool::shared(), range, fn, grain_size);
+}
+
+/// <summary>
+/// Calls fn(item) for every item in the collection, in parallel. The items are only read and written through fn; the
+/// collection itself mustn't be changed until parallel_for returns.
+/// </summary>
+template < typename Collection_T, typename Fn_T >
+requires std::invocable< Fn_T&, typename Collection_T::value_type& >
+void parallel_for(parallel_pool& pool, Collection_T& collection, Fn_T&& fn, size_t grain_size = 0) {
+  parallel_for(
+      pool, indices(collection), [&](const typename Collection_T::index_type& idx) { fn(collection.at(idx)); }, grain_size);
+}
+
+template < typename Collection_T, typename Fn_T >
+requires std::invocable< Fn_T&, typename Collection_T::value_type& >
+void parallel_for(Collection_T& collection, Fn_T&& fn, size_t grain_size = 0) {
+  parallel_for(parallel_pool::shared(), collection, fn, grain_size);
+}
+
+/// <summary>
+/// Maps each index in the range to a value with map(idx) and combines the values with reduce(lhs, rhs), in parallel,
+/// on the pool. Each thread combines the values of its own chunks, starting from identity, and then the threads'
+/// results are combined, so reduce has to be associative and commutative, and identity has to make no difference to a
+/// result.
+/// </summary>
+template < typename Index_T, typename T, typename Map_Fn, typename Reduce_Fn >
+[[nodiscard]] T parallel_reduce(parallel_pool& pool,
+                                const index_range< Index_T >& range,
+                                T identity,
+                                Map_Fn&& map,
+                                Reduce_Fn&& reduce,
+                                size_t grain_size = 0) {
+  // One result per thread, each on its own cache line.
+  struct alignas(64) partial_type {
+    std::optional< T > value;
+  };
+
+  auto partials = std::vector< partial_type >(pool.concurrency());
+  pool.run(range, grain_size, [&](size_t slot, const index_range< Index_T >& chunk) {
+    auto value = partials[slot].value ? std::move(*partials[slot].value) : identity;
+    for (auto idx : chunk) {
+      value = reduce(std::move(value), map(idx));
+    }
+
+    partials[slot].value = std::move(value);
+  });
+
+  auto out = std::move(identity);
+  for (auto&& partial : partials) {
+    if (partial.value) {
+      out = reduce(std::move(out), std::move(*partial.value));
+    }
+  }
+
+  return out;
+}
+
+template < typename Index_T, typename T, typename Map_Fn, typename Reduce_Fn >
+[[nodiscard]] T parallel_reduce(const index_range< Index_T >& range,
+                                T identity,
+                                Map_Fn&& map,
+                                Reduce_Fn&& reduce,
+                                size_t grain_size = 0) {
+  return parallel_reduce(parallel_pool::shared(), range, std::move(identity), map, reduce, grain_size);
+}
+
+/// <summary>
+/// Maps each item in the collection to a value with map(item) and combines the values with reduce, in parallel.
+/// </summary>
+template < typename Collection_T, typename T, typename Map_Fn, typename Reduce_Fn >
+requires std::invocable< Map_Fn&, const typename Collection_T::value_type& >
+[[nodiscard]] T parallel_reduce(parallel_pool& pool,
+                                const Collection_T& collection,
+                                T identity,
+                                Map_Fn&& map,
+                                Reduce_Fn&& reduce,
+                                size_t grain_size = 0) {
+  return parallel_reduce(
+      pool,
+      indices(collection),
+      std::move(identity),
+      [&](const typename Collection_T::index_type& idx) { return map(collection.at(idx)); },
+      reduce,
+      grain_size);
+}
+
+template < typename Collection_T, typename T, typename Map_Fn, typename Reduce_Fn >
+requires std::invocable< Map_Fn&, const typename Collection_T::value_type& >
+[[nodiscard]] T parallel_reduce(const Collection_T& collection,
+                                T identity,
+                                Map_Fn&& map,
+                                Reduce_Fn&& reduce,
+                                size_t grain_size = 0) {
+  return parallel_reduce(parallel_pool::shared(), collection, std::move(identity), map, reduce, grain_size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <typed/key_traits.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <ranges>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace typed {
+
+///////////////////////////////////////////////////////////////////////////////
+
+template < typename Item_T, typename Index_T, typename... SecondaryIndex_Ts >
+class identifiable_item_collection;
+
+namespace detail {
+
+/// <summary>
+/// The type-level description of a secondary index: what it's called (the tag), how to get its key from an item (the
+/// projection, e.g. a pointer to a data member or a member function) and how it's organised. Use the aliases below
+/// rather than this directly.
+/// </summary>
+template < typename Tag_T, auto Projection, bool Ordered, bool Unique >
+struct secondary_index_spec {
+  using tag_type = Tag_T;
+
+  static constexpr auto projection = Projection;
+  static constexpr bool ordered    = Ordered;
+  static constexpr bool unique     = Unique;
+};
+
+}  // namespace detail
+
+/// <summary>
+/// Secondary indexes, for looking items up by something other than their ID. Add them to a collection as extra template
+/// arguments, after the index type, e.g.
+///
+///   struct by_facility {};
+///   using Printers = identifiable_item_collection< Printer, size_t, ordered_non_unique< by_facility, &Printer::facility > >;
+///
+/// Hashed indexes look keys up in constant time; ordered ones take logarithmic time, but can also find ranges of keys.
+/// Adding an item whose key is already in a unique index fails, in the same way as adding an item with an existing ID.
+/// </summary>
+template < typename Tag_T, auto Projection >
+using hashed_unique = detail::secondary_index_spec< Tag_T, Projection, false, true >;
+
+template < typename Tag_T, auto Projection >
+using hashed_non_unique = detail::secondary_index_spec< Tag_T, Projection, false, false >;
+
+template < typename Tag_T, auto Projection >
+using ordered_unique = detail::secondary_index_spec< Tag_T, Projection, true, true >;
+
+template < typename Tag_T, auto Projection >
+using ordered_non_unique = detail::secondary_index_spec< Tag_T, Projection, true, false >;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// A secondary index of a collection, which the collection keeps up to date as items are added and removed. Get one
+/// with the collection's by< Tag >(). Lookups take a key of exactly the type the projection returns, so if that's a
+/// typed ID, only an ID of the right type will do.
+///
+/// The index holds on to a copy of each item's key, so the indexed members of an item mustn't be changed while the
+/// item is in the collection (just like its ID).
+/// </summary>
+template < typename Item_T, typename Spec_T >
+class secondary_index {
+ public:
+  using value_type = Item_T;
+  using tag_type   = typename Spec_T::tag_type;
+  using key_type   = std::remove_cvref_t< std::invoke_result_t< decltype(Spec_T::projection), const value_type& > >;
+
+  static constexpr bool is_ordered = Spec_T::ordered;
+  static constexpr bool is_unique  = Spec_T::unique;
+
+  [[nodiscard]] size_t size() const noexcept { return _entries.size(); }
+
+  [[nodiscard]] size_t count(const key_type& key) const { return _entries.count(key); }
+
+  /// <summary>
+  /// An estimate of the memory the index is using, in bytes. The standard containers don't say how much they allocate,
+  /// so this assumes the usual layouts: a tree node holds three pointers and a colour, a hash node a next pointer and
+  /// the hash, and a hash table has an array of bucket pointers. A non-unique index also has a hash table that says
+  /// where each item's entry is.
+  /// </summary>
+  [[nodiscard]] size_t memory_usage() const noexcept {
+    using entry_type = typename _map_type::value_type;
+    if constexpr (is_ordered) {
+      return _entries.size() * (sizeof(entry_type) + 4 * sizeof(void*)) + _handles_memory_usage();
+    } else {
+      return _entries.size() * (sizeof(entry_type) + 2 * sizeof(void*)) + _entries.bucket_count() * sizeof(void*) +
+             _handles_memory_usage();
+    }
+  }
+
+  [[nodiscard]] bool contains(const key_type& key) const { return _entries.end() != _entries.find(key); }
+
+  /// <summary>
+  /// Returns an item with the given key, or nullptr if there isn't one. For a non-unique index, use equal_range to get
+  /// all of them.
+  /// </summary>
+  [[nodiscard]] const value_type* find(const key_type& key) const {
+    const auto match = _entries.find(key);
+    return _entries.end() != match ? match->second : nullptr;
+  }
+
+  [[nodiscard]] value_type* find(const key_type& key) {
+    return const_cast< value_type* >(const_cast< const secondary_index* >(this)->find(key));
+  }
+
+  /// <summary>
+  /// All the items with the given key, as a range of references. An ordered index gives them in the same order as they
+  /// are in the collection.
+  /// </summary>
+  [[nodiscard]] auto equal_range(const key_type& key) const {
+    const auto [first, last] = _entries.equal_range(key);
+    return _items< const value_type >(first, last);
+  }
+
+  [[nodiscard]] auto equal_range(const key_type& key) {
+    const auto [first, last] = _entries.equal_range(key);
+    return _items< value_type >(first, last);
+  }
+
+  /// <summary>
+  /// All the items with keys in [from, to), in key order.
+  /// </summary>
+  [[nodiscard]] auto range(const key_type& from, const key_type& to) const requires is_ordered {
+    return _items< const value_type >(_entries.lower_bound(from), _entries.lower_bound(to));
+  }
+
+  [[nodiscard]] auto range(const key_type& from, const key_type& to) requires is_ordered {
+    return _items< value_type >(_entries.lower_bound(from), _entries.lower_bound(to));
+  }
+
+  /// <summary>
+  /// All the items with keys that start with the given prefix, in key order, for string-like keys. Keys starting with
+  /// the prefix sort next to each other, so this is a search for the first one and then a walk until they stop matching.
+  /// </summary>
+  template < typename Prefix_T >
+  [[nodiscard]] auto starting_with(const Prefix_T& prefix) const
+      requires is_ordered and requires(const key_type& key) { { key.starts_with(prefix) } -> std::convertible_to< bool >; } {
+    const auto [first, last] = _prefix_range(prefix);
+    return _items< const value_type >(first, last);
+  }
+
+  template < typename Prefix_T >
+  [[nodiscard]] auto starting_with(const Prefix_T& prefix)
+      requires is_ordered and requires(const key_type& key) { { key.starts_with(prefix) } -> std::convertible_to< bool >; } {
+    const auto [first, last] = _prefix_range(prefix);
+    return _items< value_type >(first, last);
+  }
+
+ private:
+  template < typename, typename, typename... >
+  friend class identifiable_item_collection;
+
+  template < typename Key_T, typename Mapped_T >
+  using _unique_map_type = std::conditional_t< is_ordered,
+                                               std::map< Key_T, Mapped_T, std::less<> >,
+                                               std::unordered_map< Key_T, Mapped_T, key_hash< Key_T > > >;
+
+  template < typename Key_T, typename Mapped_T >
+  using _multi_map_type = std::conditional_t< is_ordered,
+                                              std::multimap< Key_T, Mapped_T, std::less<> >,
+                                              std::unordered_multimap< Key_T, Mapped_T, key_hash< Key_T > > >;
+
+  using _map_type = std::conditional_t< is_unique,
+                                        _unique_map_type< key_type, value_type* >,
+                                        _multi_map_type< key_type, value_type* > >;
+
+  // In a non-unique index, many items can have the same key, so finding one item's entry by its key would mean going
+  // through all of them. Instead, each item's entry is looked up by the item's address.
+  struct _no_handles_type {};
+
+  using _handles_type = std::conditional_t< is_unique,
+                                            _no_handles_type,
+                                            std::unordered_map< const value_type*, typename _map_type::iterator > >;
+
+  [[nodiscard]] static decltype(auto) _key(const value_type& item) { return std::invoke(Spec_T::projection, item); }
+
+  template < typename Ref_T, typename Iter_T >
+  [[nodiscard]] static auto _items(Iter_T first, Iter_T last) {
+    return std::ranges::subrange{first, last} |
+           std::views::transform([](auto&& entry) -> Ref_T& { return *entry.second; });
+  }
+
+  template < typename Prefix_T >
+  [[nodiscard]] auto _prefix_range(const Prefix_T& prefix) const {
+    auto first = _entries.lower_bound(prefix);
+    auto last  = first;
+    while (_entries.end() != last and last->first.starts_with(prefix)) {
+      ++last;
+    }
+
+    return std::pair{first, last};
+  }
+
+  // The item already in a unique index with the same key as the given item, if there is one.
+  [[nodiscard]] value_type* _conflict(const value_type& item) const {
+    if constexpr (is_unique) {
+      const auto match = _entries.find(_key(item));
+      return _entries.end() != match ? match->second : nullptr;
+    } else {
+      return nullptr;
+    }
+  }
+
+  void _insert(value_type* item) {
+    if constexpr (is_unique) {
+      _entries.emplace(_key(*item), item);
+    } else {
+      const auto buckets = _bucket_count();
+      const auto entry   = _entries.emplace(_key(*item), item);
+      if (buckets == _bucket_count()) {
+        _handles.emplace(item, entry);
+      } else {
+        _refresh_handles();
+      }
+    }
+  }
+
+  void _erase(const value_type& item) {
+    const auto entry = _find_entry(item);
+    if (_entries.end() != entry) {
+      _entries.erase(entry);
+      if constexpr (not is_unique) {
+        _handles.erase(&item);
+      }
+    }
+  }
+
+  // Points the entry for an item that has moved at its new address.
+  void _relocate(const value_type* from, value_type* to) {
+    if constexpr (is_unique) {
+      const auto entry = _entries.find(_key(*to));
+      if (_entries.end() != entry and from == entry->second) {
+        entry->second = to;
+      }
+    } else {
+      auto handle = _handles.extract(from);
+      if (not handle.empty()) {
+        handle.mapped()->second = to;
+        handle.key()            = to;
+        _handles.insert(std::move(handle));
+      }
+    }
+  }
+
+  // Gives back any memory the index doesn't need for the items it has.
+  void _shrink() {
+    if constexpr (not is_ordered) {
+      _entries.rehash(0);
+    }
+
+    if constexpr (not is_unique) {
+      _refresh_handles();
+    }
+  }
+
+  void _clear() noexcept {
+    _entries.clear();
+    if constexpr (not is_unique) {
+      _handles.clear();
+    }
+  }
+
+  [[nodiscard]] auto _find_entry(const value_type& item) {
+    if constexpr (is_unique) {
+      const auto entry = _entries.find(_key(item));
+      return _entries.end() != entry and &item == entry->second ? entry : _entries.end();
+    } else {
+      const auto handle = _handles.find(&item);
+      return _handles.end() != handle ? handle->second : _entries.end();
+    }
+  }
+
+  [[nodiscard]] size_t _bucket_count() const noexcept {
+    if constexpr (is_ordered) {
+      return 0;
+    } else {
+      return _entries.bucket_count();
+    }
+  }
+
+  // A rehash invalidates the iterators into a hash table, so they all have to be looked up again.
+  void _refresh_handles() {
+    if constexpr (not is_ordered and not is_unique) {
+      for (auto entry = _entries.begin(); _entries.end() != entry; ++entry) {
+        _handles.insert_or_assign(entry->second, entry);
+      }
+    }
+  }
+
+  [[nodiscard]] size_t _handles_memory_usage() const noexcept {
+    if constexpr (is_unique) {
+      return 0;
+    } else {
+      using handle_type = typename _handles_type::value_type;
+      return _handles.size() * (sizeof(handle_type) + sizeof(void*)) + _handles.bucket_count() * sizeof(void*);
+    }
+  }
+
+  _map_type _entries;
+  [[no_unique_address]] _handles_type _handles;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace typed
+
+///////////////////////////////////////////////////////////////////////////////
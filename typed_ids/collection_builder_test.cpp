@@ -0,0 +1,110 @@
+#include <typed/collection_builder.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Hen : public typed::identifiable< Hen, size_t > {
+  Hen(size_t id, size_t coop = 0) : typed::identifiable< Hen, size_t >{id}, coop{coop} {}
+
+  size_t coop;
+};
+
+using Hens        = typed::identifiable_item_collection< Hen, size_t >;
+using HensBuilder = typed::collection_builder< Hens >;
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(CollectionBuilderTests, EmptyBuilderBuildsAnEmptyCollection) {
+  auto builder = HensBuilder{4};
+  ASSERT_EQ(Hens::size_type{0}, builder.build().size());
+}
+
+TEST(CollectionBuilderTests, ItemsComeOutInPartialOrder) {
+  auto builder = HensBuilder{3};
+  builder.partial(1).add(Hen{10});
+  builder.partial(1).add(Hen{5});
+  builder.partial(0).add(Hen{7});
+  builder.partial(2).add(Hen{1});
+
+  const auto hens = builder.build(2);
+
+  ASSERT_EQ(Hens::size_type{4}, hens.size());
+  ASSERT_EQ(Hen::id_type{7}, hens.at(Hens::index_type{0}).id());
+  ASSERT_EQ(Hen::id_type{10}, hens.at(Hens::index_type{1}).id());
+  ASSERT_EQ(Hen::id_type{5}, hens.at(Hens::index_type{2}).id());
+  ASSERT_EQ(Hen::id_type{1}, hens.at(Hens::index_type{3}).id());
+}
+
+TEST(CollectionBuilderTests, DuplicatesKeepTheItemFromTheEarliestPartial) {
+  auto builder = HensBuilder{3};
+  builder.partial(2).add(Hen{1, 2});
+  builder.partial(1).add(Hen{1, 1});
+  builder.partial(1).add(Hen{2, 1});
+  builder.partial(2).add(Hen{2, 2});
+  builder.partial(2).add(Hen{3, 2});
+
+  const auto hens = builder.build();
+
+  ASSERT_EQ(Hens::size_type{3}, hens.size());
+  ASSERT_EQ(size_t{1}, hens.find(Hen::id_type{1})->coop);
+  ASSERT_EQ(size_t{1}, hens.find(Hen::id_type{2})->coop);
+  ASSERT_EQ(size_t{2}, hens.find(Hen::id_type{3})->coop);
+}
+
+TEST(CollectionBuilderTests, PartialsAreEmptyAfterBuilding) {
+  auto builder = HensBuilder{2};
+  builder.partial(0).add(Hen{1});
+  builder.partial(1).add(Hen{2});
+
+  const auto hens = builder.build();
+
+  ASSERT_EQ(Hens::size_type{2}, hens.size());
+  ASSERT_EQ(Hens::size_type{0}, builder.partial(0).size());
+  ASSERT_EQ(Hens::size_type{0}, builder.partial(1).size());
+}
+
+TEST(CollectionBuilderTests, FillingFromManyThreadsMatchesAddingInPartialOrder) {
+  constexpr auto thread_count = size_t{8};
+  constexpr auto per_thread   = size_t{500};
+
+  auto builder = HensBuilder{thread_count};
+  {
+    auto threads = std::vector< std::jthread >{};
+    for (auto t = size_t{0}; t < thread_count; ++t) {
+      threads.emplace_back([&builder, t] {
+        for (auto i = size_t{0}; i < per_thread; ++i) {
+          builder.partial(t).add(Hen{(t * per_thread / 2 + i * 7) % (thread_count * per_thread / 2), t});
+        }
+      });
+    }
+  }
+
+  auto expected = Hens{};
+  for (auto t = size_t{0}; t < thread_count; ++t) {
+    for (auto i = Hens::index_type{0}; i < builder.partial(t).size(); ++i) {
+      expected.add(builder.partial(t).at(i));
+    }
+  }
+
+  const auto hens = builder.build(thread_count);
+
+  ASSERT_EQ(expected.size(), hens.size());
+  for (auto i = Hens::index_type{0}; i < hens.size(); ++i) {
+    ASSERT_EQ(expected.at(i).id(), hens.at(i).id());
+    ASSERT_EQ(expected.at(i).coop, hens.at(i).coop);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,213 @@
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/io/collection_loader.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Goose : public typed::identifiable< Goose, std::string > {
+  explicit Goose(id_type id) : typed::identifiable< Goose, std::string >{std::move(id)} {}
+  Goose(std::string id, int weight) : typed::identifiable< Goose, std::string >{std::move(id)}, weight{weight} {}
+
+  int weight{0};
+};
+
+using Geese       = typed::identifiable_item_collection< Goose, size_t >;
+using GeeseLoader = typed::collection_loader< Geese >;
+
+std::string make_records(size_t count) {
+  auto out = std::ostringstream{};
+  for (auto i = size_t{0}; i < count; ++i) {
+    out << "goose-" << i << "\n";
+  }
+
+  return out.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(CollectionLoaderTests, LoadsEveryRecordInStreamOrder) {
+  auto in     = std::istringstream{make_records(1000)};
+  auto loader = GeeseLoader{&GeeseLoader::parse_id, 3, 2, 7};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{1000}, geese.size());
+  for (auto i = Geese::index_type{0}; i < geese.size(); ++i) {
+    ASSERT_EQ(Goose::id_type{"goose-" + std::to_string(i.get())}, geese.at(i).id());
+  }
+}
+
+TEST(CollectionLoaderTests, EmptyStreamGivesEmptyCollection) {
+  auto in     = std::istringstream{};
+  auto loader = GeeseLoader{};
+
+  ASSERT_EQ(Geese::size_type{0}, loader.load(in).get().size());
+  ASSERT_TRUE(loader.progress().done);
+}
+
+TEST(CollectionLoaderTests, EmptyLinesAreSkipped) {
+  auto in     = std::istringstream{"goose-1\n\n\ngoose-2\n"};
+  auto loader = GeeseLoader{};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{2}, geese.size());
+  ASSERT_EQ(size_t{2}, loader.progress().read);
+}
+
+TEST(CollectionLoaderTests, DuplicateIdsAreRejected) {
+  auto in     = std::istringstream{"goose-1\ngoose-2\ngoose-1\n"};
+  auto loader = GeeseLoader{};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{2}, geese.size());
+
+  const auto progress = loader.progress();
+  ASSERT_EQ(size_t{3}, progress.read);
+  ASSERT_EQ(size_t{3}, progress.parsed);
+  ASSERT_EQ(size_t{2}, progress.inserted);
+  ASSERT_EQ(size_t{1}, progress.rejected);
+  ASSERT_TRUE(progress.done);
+}
+
+TEST(CollectionLoaderTests, RecordsWithMoreThanAnIdAreRejected) {
+  auto in     = std::istringstream{"goose-1\ngoose-2 extra\n goose-3 \ngoose-4\tgoose-5\n"};
+  auto loader = GeeseLoader{};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{2}, geese.size());
+  ASSERT_NE(nullptr, geese.find(Goose::id_type{"goose-1"}));
+  ASSERT_NE(nullptr, geese.find(Goose::id_type{"goose-3"}));
+  ASSERT_EQ(size_t{2}, loader.progress().rejected);
+}
+
+TEST(CollectionLoaderTests, NumericIdsWithTrailingCharactersAreRejected) {
+  struct Egg : public typed::identifiable< Egg, size_t > {
+    explicit Egg(id_type id) : typed::identifiable< Egg, size_t >{id} {}
+  };
+
+  using Eggs = typed::identifiable_item_collection< Egg, size_t >;
+
+  auto in     = std::istringstream{"12\n12abc\n1 goose\n7\n3.5\n"};
+  auto loader = typed::collection_loader< Eggs >{};
+
+  const auto eggs = loader.load(in).get();
+
+  ASSERT_EQ(Eggs::size_type{2}, eggs.size());
+  ASSERT_EQ(Egg::id_type{12}, eggs.at(Eggs::index_type{0}).id());
+  ASSERT_EQ(Egg::id_type{7}, eggs.at(Eggs::index_type{1}).id());
+  ASSERT_EQ(size_t{3}, loader.progress().rejected);
+}
+
+TEST(CollectionLoaderTests, LoadedCollectionsAreIndexedLazily) {
+  auto in     = std::istringstream{make_records(100)};
+  auto loader = GeeseLoader{};
+
+  auto geese = loader.load(in).get();
+  ASSERT_FALSE(geese.index_state().built);
+
+  ASSERT_NE(nullptr, geese.find(Goose::id_type{"goose-42"}));
+  ASSERT_TRUE(geese.index_state().built);
+}
+
+TEST(CollectionLoaderTests, UsesTheGivenParser) {
+  auto in     = std::istringstream{"goose-1 12\ngoose-2 7\nnot-a-goose\n"};
+  auto loader = GeeseLoader{[](std::string_view record) -> std::unique_ptr< Goose > {
+    auto fields = std::istringstream{std::string{record}};
+    auto id     = std::string{};
+    auto weight = 0;
+    if (not(fields >> id >> weight)) {
+      return nullptr;
+    }
+
+    return std::make_unique< Goose >(std::move(id), weight);
+  }};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{2}, geese.size());
+  ASSERT_EQ(12, geese.find(Goose::id_type{"goose-1"})->weight);
+  ASSERT_EQ(7, geese.find(Goose::id_type{"goose-2"})->weight);
+  ASSERT_EQ(size_t{1}, loader.progress().rejected);
+}
+
+TEST(CollectionLoaderTests, EarlierRecordsWinOverLaterDuplicates) {
+  auto in     = std::istringstream{"goose-1 1\ngoose-2 2\ngoose-1 3\ngoose-3 4\ngoose-2 5\n"};
+  auto loader = GeeseLoader{[](std::string_view record) -> std::unique_ptr< Goose > {
+                              auto fields = std::istringstream{std::string{record}};
+                              auto id     = std::string{};
+                              auto weight = 0;
+                              fields >> id >> weight;
+                              return std::make_unique< Goose >(std::move(id), weight);
+                            },
+                            2,
+                            1,
+                            1};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{3}, geese.size());
+  ASSERT_EQ(1, geese.at(Geese::index_type{0}).weight);
+  ASSERT_EQ(2, geese.at(Geese::index_type{1}).weight);
+  ASSERT_EQ(4, geese.at(Geese::index_type{2}).weight);
+  ASSERT_EQ(size_t{3}, loader.progress().inserted);
+  ASSERT_EQ(size_t{2}, loader.progress().rejected);
+}
+
+TEST(CollectionLoaderTests, ASlowParserDoesNotStopTheLoad) {
+  auto in     = std::istringstream{make_records(2000)};
+  auto loader = GeeseLoader{[](std::string_view record) -> std::unique_ptr< Goose > {
+                              if ("goose-0" == record) {
+                                std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                              }
+
+                              return GeeseLoader::parse_id(record);
+                            },
+                            4,
+                            2,
+                            8};
+
+  const auto geese = loader.load(in).get();
+
+  ASSERT_EQ(Geese::size_type{2000}, geese.size());
+  for (auto i = Geese::index_type{0}; i < geese.size(); ++i) {
+    ASSERT_EQ(Goose::id_type{"goose-" + std::to_string(i.get())}, geese.at(i).id());
+  }
+}
+
+TEST(CollectionLoaderTests, ParserExceptionsComeOutOfTheFuture) {
+  auto in     = std::istringstream{make_records(5000)};
+  auto loader = GeeseLoader{[](std::string_view record) -> std::unique_ptr< Goose > {
+                              if ("goose-1234" == record) {
+                                throw std::runtime_error{"bad goose"};
+                              }
+
+                              return GeeseLoader::parse_id(record);
+                            },
+                            2,
+                            1,
+                            16};
+
+  auto geese = loader.load(in);
+
+  ASSERT_THROW(geese.get(), std::runtime_error);
+  ASSERT_TRUE(loader.progress().done);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,210 @@
+#include <typed/collection_view.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// What a plugin knows about the items.
+struct Singer {
+  virtual ~Singer() = default;
+  [[nodiscard]] virtual std::string song() const = 0;
+};
+
+struct Thrush
+    : public typed::identifiable< Thrush, size_t >
+    , public Singer {
+  Thrush(size_t id, std::string song) : typed::identifiable< Thrush, size_t >{id}, _song{std::move(song)} {}
+
+  [[nodiscard]] std::string song() const override { return _song; }
+
+ private:
+  std::string _song;
+};
+
+using Thrushes = typed::identifiable_item_collection< Thrush >;
+
+struct Wren : public typed::identifiable< Wren, std::string > {
+  explicit Wren(std::string id) : typed::identifiable< Wren, std::string >{std::move(id)} {}
+};
+
+using Wrens = typed::identifiable_item_collection< Wren >;
+
+using SingerView = typed::identifiable_collection_view< Singer, size_t >;
+
+// The sort of thing a plugin would do, without knowing anything about Thrush.
+std::vector< std::string > songs_of(const SingerView& singers, const std::vector< size_t >& ids) {
+  auto found = std::vector< const Singer* >(ids.size());
+  singers.find_many(ids, found);
+
+  auto out = std::vector< std::string >{};
+  for (auto&& singer : found) {
+    out.push_back(nullptr != singer ? singer->song() : "");
+  }
+
+  return out;
+}
+
+class CollectionViewTests : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (auto i = size_t{0}; i < 1000; ++i) {
+      thrushes.add(Thrush{i, "song " + std::to_string(i)});
+    }
+  }
+
+  Thrushes thrushes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CollectionViewTests, SizeIsTheSizeOfTheCollection) {
+  const auto view = typed::make_collection_view< Singer >(thrushes);
+  ASSERT_EQ(1000, view.size());
+}
+
+TEST_F(CollectionViewTests, FindManyFindsItemsThroughTheInterface) {
+  const auto view  = typed::make_collection_view< Singer >(thrushes);
+  const auto songs = songs_of(view, {5, 999, 0});
+
+  ASSERT_EQ((std::vector< std::string >{"song 5", "song 999", "song 0"}), songs);
+}
+
+TEST_F(CollectionViewTests, FindManyGivesNullForMissingIds) {
+  const auto view  = typed::make_collection_view< Singer >(thrushes);
+  const auto songs = songs_of(view, {1, 5000, 2});
+
+  ASSERT_EQ((std::vector< std::string >{"song 1", "", "song 2"}), songs);
+}
+
+TEST_F(CollectionViewTests, FindManyHandlesBatchesBiggerThanASlice) {
+  auto ids = std::vector< size_t >(3000);
+  std::iota(ids.rbegin(), ids.rend(), size_t{0});
+
+  const auto view = typed::make_collection_view< Thrush >(thrushes);
+  auto found      = std::vector< const Thrush* >(ids.size());
+  view.find_many(ids, found);
+
+  for (auto i = size_t{0}; i < ids.size(); ++i) {
+    ASSERT_EQ(thrushes.find(Thrush::id_type{ids[i]}), found[i]);
+  }
+}
+
+TEST_F(CollectionViewTests, FindManyWorksWithUnpackableIds) {
+  auto wrens = Wrens{};
+  wrens.add(Wren{"jenny"});
+  wrens.add(Wren{"cactus"});
+
+  const auto view = typed::make_collection_view< Wren >(wrens);
+  const auto ids  = std::vector< std::string >{"cactus", "rock", "jenny"};
+  auto found      = std::vector< const Wren* >(ids.size());
+  view.find_many(ids, found);
+
+  ASSERT_EQ(wrens.find(Wren::id_type{"cactus"}), found[0]);
+  ASSERT_EQ(nullptr, found[1]);
+  ASSERT_EQ(wrens.find(Wren::id_type{"jenny"}), found[2]);
+}
+
+TEST_F(CollectionViewTests, FindManyBuildsTheIndexOfANonConstCollection) {
+  const auto view = typed::make_collection_view< Singer >(thrushes);
+  songs_of(view, {5});
+
+  ASSERT_TRUE(thrushes.index_state().built);
+}
+
+TEST_F(CollectionViewTests, FindManyLeavesAConstCollectionAlone) {
+  const auto& const_thrushes = thrushes;
+  const auto view            = typed::make_collection_view< Singer >(const_thrushes);
+
+  ASSERT_EQ((std::vector< std::string >{"song 5"}), songs_of(view, {5}));
+  ASSERT_FALSE(thrushes.index_state().built);
+}
+
+TEST_F(CollectionViewTests, ReadStopsAtTheEndOfTheCollection) {
+  const auto view = typed::make_collection_view< Singer >(thrushes);
+  auto out        = std::vector< const Singer* >(10);
+
+  ASSERT_EQ(10, view.read(0, out));
+  ASSERT_EQ("song 0", out[0]->song());
+  ASSERT_EQ(4, view.read(996, out));
+  ASSERT_EQ("song 999", out[3]->song());
+  ASSERT_EQ(0, view.read(1000, out));
+  ASSERT_EQ(0, view.read(5000, out));
+}
+
+TEST_F(CollectionViewTests, ForEachChunkVisitsEveryItemInOrder) {
+  const auto view = typed::make_collection_view< Singer >(thrushes);
+
+  auto songs  = std::vector< std::string >{};
+  auto chunks = 0;
+  auto buffer = std::vector< const Singer* >(300);
+  view.for_each_chunk(
+      [&](auto chunk) {
+        ++chunks;
+        for (auto&& singer : chunk) {
+          songs.push_back(singer->song());
+        }
+      },
+      buffer);
+
+  ASSERT_EQ(4, chunks);
+  ASSERT_EQ(1000, songs.size());
+  for (auto i = size_t{0}; i < songs.size(); ++i) {
+    ASSERT_EQ("song " + std::to_string(i), songs[i]);
+  }
+}
+
+TEST(CollectionViewEmptyTests, ForEachChunkOnAnEmptyCollectionDoesNothing) {
+  const auto thrushes = Thrushes{};
+  const auto view     = typed::make_collection_view< Singer >(thrushes);
+
+  auto calls = 0;
+  view.for_each_chunk([&](auto) { ++calls; });
+  ASSERT_EQ(0, calls);
+}
+
+TEST(CollectionViewEmptyTests, ViewsOfDifferentCollectionsShareAnInterface) {
+  struct Blackbird
+      : public typed::identifiable< Blackbird, size_t >
+      , public Singer {
+    explicit Blackbird(size_t id) : typed::identifiable< Blackbird, size_t >{id} {}
+    [[nodiscard]] std::string song() const override { return "fluting"; }
+  };
+
+  auto thrushes = Thrushes{};
+  thrushes.add(Thrush{1, "repeated phrases"});
+  auto blackbirds = typed::identifiable_item_collection< Blackbird >{};
+  blackbirds.add(Blackbird{1});
+
+  const auto thrush_view    = typed::make_collection_view< Singer >(thrushes);
+  const auto blackbird_view = typed::make_collection_view< Singer >(blackbirds);
+  const auto views          = std::vector< const SingerView* >{&thrush_view, &blackbird_view};
+
+  ASSERT_EQ((std::vector< std::string >{"repeated phrases"}), songs_of(*views[0], {1}));
+  ASSERT_EQ((std::vector< std::string >{"fluting"}), songs_of(*views[1], {1}));
+}
+
+template < typename Interface_T, typename Collection_T >
+concept can_view_as = requires(const Collection_T& collection) { typed::make_collection_view< Interface_T >(collection); };
+
+TEST(CollectionViewEmptyTests, CollectionsCanOnlyBeViewedThroughABaseOfTheirItems) {
+  static_assert(can_view_as< Singer, Thrushes >);
+  static_assert(can_view_as< Thrush, Thrushes >);
+  static_assert(can_view_as< Wren, Wrens >);
+
+  static_assert(not can_view_as< Singer, Wrens >);
+  static_assert(not can_view_as< Thrush, Wrens >);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,329 @@
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/secondary_index.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct by_colony {};
+struct by_name {};
+struct by_wingspan {};
+
+struct Gull : public typed::identifiable< Gull, size_t > {
+  Gull(size_t id, std::string name, int wingspan)
+      : typed::identifiable< Gull, size_t >{id}
+      , name{std::move(name)}
+      , wingspan{wingspan} {}
+
+  virtual ~Gull() = default;
+
+  Gull(Gull&&) = default;
+
+  [[nodiscard]] virtual std::string call() const { return "mew"; }
+
+  [[nodiscard]] int colony() const noexcept { return static_cast< int >(id().get() % 3); }
+
+  std::string name;
+  int wingspan;
+};
+
+struct HerringGull : public Gull {
+  using Gull::Gull;
+
+  [[nodiscard]] std::string call() const override { return "kyow"; }
+};
+
+using Gulls = typed::identifiable_item_collection< Gull,
+                                                   size_t,
+                                                   typed::hashed_unique< by_name, &Gull::name >,
+                                                   typed::ordered_non_unique< by_wingspan, &Gull::wingspan >,
+                                                   typed::hashed_non_unique< by_colony, &Gull::colony > >;
+
+struct Tern : public typed::identifiable< Tern, std::string > {
+  explicit Tern(std::string id, int colony)
+      : typed::identifiable< Tern, std::string >{std::move(id)}
+      , colony{colony} {}
+
+  int colony;
+};
+
+using Terns = typed::identifiable_item_collection< Tern >;
+
+Gulls make_gulls(size_t count) {
+  auto gulls = Gulls{};
+  gulls.build_index();
+  for (auto i = size_t{0}; i < count; ++i) {
+    gulls.add(Gull{i, "gull " + std::to_string(i), static_cast< int >(100 + i % 7)});
+  }
+
+  return gulls;
+}
+
+void assert_gulls_intact(const Gulls& gulls) {
+  for (auto i = size_t{0}; i < gulls.size().get(); ++i) {
+    const auto& gull = gulls.at(Gulls::index_type{i});
+    ASSERT_EQ(&gull, gulls.find(gull.id()));
+    ASSERT_EQ(&gull, gulls.by< by_name >().find(gull.name));
+
+    auto found = false;
+    for (auto&& match : gulls.by< by_wingspan >().equal_range(gull.wingspan)) {
+      found = found or &match == &gull;
+    }
+    ASSERT_TRUE(found);
+
+    found = false;
+    for (auto&& match : gulls.by< by_colony >().equal_range(gull.colony())) {
+      found = found or &match == &gull;
+    }
+    ASSERT_TRUE(found);
+  }
+
+  ASSERT_EQ(gulls.size().get(), gulls.by< by_wingspan >().size());
+  ASSERT_EQ(gulls.size().get(), gulls.by< by_colony >().size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(CompactionTests, ItemsAddedOneAtATimeAreFragmented) {
+  const auto gulls = make_gulls(100);
+  ASSERT_GT(gulls.memory_usage().fragmentation, 0.0);
+}
+
+TEST(CompactionTests, CompactingLaysItemsOutContiguously) {
+  auto gulls = make_gulls(100);
+  gulls.compact();
+
+  ASSERT_EQ(0.0, gulls.memory_usage().fragmentation);
+  for (auto i = size_t{1}; i < 100; ++i) {
+    ASSERT_EQ(&gulls.at(Gulls::index_type{i - 1}) + 1, &gulls.at(Gulls::index_type{i}));
+  }
+}
+
+TEST(CompactionTests, CompactingKeepsItemsAndOrder) {
+  auto gulls = make_gulls(100);
+  gulls.compact();
+
+  ASSERT_EQ(100, gulls.size().get());
+  for (auto i = size_t{0}; i < 100; ++i) {
+    ASSERT_EQ(i, gulls.at(Gulls::index_type{i}).id().get());
+    ASSERT_EQ("gull " + std::to_string(i), gulls.at(Gulls::index_type{i}).name);
+  }
+}
+
+TEST(CompactionTests, CompactingKeepsTheIndexesPointingAtTheItems) {
+  auto gulls = make_gulls(100);
+  gulls.compact();
+  assert_gulls_intact(gulls);
+}
+
+TEST(CompactionTests, CompactingKeepsTheIndexOfUnpackableIdsPointingAtTheItems) {
+  auto terns = Terns{};
+  terns.build_index();
+  for (auto i = 0; i < 100; ++i) {
+    terns.add(Tern{"tern " + std::to_string(i), i});
+  }
+
+  terns.compact();
+
+  ASSERT_EQ(0.0, terns.memory_usage().fragmentation);
+  for (auto i = 0; i < 100; ++i) {
+    const auto tern = terns.find(Tern::id_type{"tern " + std::to_string(i)});
+    ASSERT_NE(nullptr, tern);
+    ASSERT_EQ(i, tern->colony);
+  }
+}
+
+TEST(CompactionTests, CompactingKeepsItemsWithEqualKeysInCollectionOrder) {
+  auto gulls = make_gulls(1000);
+  for (auto i = size_t{0}; i < 1000; i += 2) {
+    gulls.remove(Gull::id_type{i});
+  }
+
+  gulls.compact();
+
+  auto expected = std::vector< size_t >{};
+  for (auto i = size_t{7}; i < 1000; i += 14) {
+    expected.push_back(i);
+  }
+
+  auto ids = std::vector< size_t >{};
+  for (auto&& gull : gulls.by< by_wingspan >().equal_range(100)) {
+    ids.push_back(gull.id().get());
+  }
+
+  ASSERT_EQ(expected, ids);
+  assert_gulls_intact(gulls);
+}
+
+TEST(CompactionTests, ItemsOfDerivedTypesAreLeftWhereTheyAre) {
+  auto gulls = make_gulls(10);
+  gulls.add(std::make_unique< HerringGull >(10, "herring", 140));
+  const auto herring = gulls.find(Gull::id_type{10});
+
+  gulls.compact();
+
+  ASSERT_EQ(herring, gulls.find(Gull::id_type{10}));
+  ASSERT_EQ("kyow", herring->call());
+  ASSERT_EQ("mew", gulls.find(Gull::id_type{0})->call());
+}
+
+TEST(CompactionTests, CompactingInSlicesGetsThereInTheEnd) {
+  auto gulls = make_gulls(1000);
+
+  auto slices = 0;
+  while (not gulls.compact(std::chrono::nanoseconds{0})) {
+    ++slices;
+  }
+
+  ASSERT_GT(slices, 0);
+  ASSERT_EQ(0.0, gulls.memory_usage().fragmentation);
+  assert_gulls_intact(gulls);
+}
+
+TEST(CompactionTests, CompactingInSlicesLeavesTheContainersForShrinkToFit) {
+  // Growing the containers an item at a time leaves them with spare capacity.
+  auto gulls = make_gulls(1000);
+  const auto unused = gulls.memory_usage().unused;
+  ASSERT_GT(unused, 0);
+
+  while (not gulls.compact(std::chrono::nanoseconds{0})) {
+  }
+
+  ASSERT_EQ(0.0, gulls.memory_usage().fragmentation);
+  ASSERT_EQ(unused, gulls.memory_usage().unused);
+
+  gulls.shrink_to_fit();
+
+  ASSERT_EQ(0, gulls.memory_usage().unused);
+  assert_gulls_intact(gulls);
+}
+
+TEST(CompactionTests, CollectionCanBeChangedBetweenSlices) {
+  auto gulls = make_gulls(1000);
+  ASSERT_FALSE(gulls.compact(std::chrono::nanoseconds{0}));
+
+  // Remove one item that has already moved and one that hasn't, and add one that won't be moved.
+  ASSERT_NE(nullptr, gulls.remove(Gull::id_type{1}));
+  ASSERT_NE(nullptr, gulls.remove(Gull::id_type{900}));
+  gulls.add(Gull{5000, "late", 99});
+
+  while (not gulls.compact(std::chrono::nanoseconds{0})) {
+  }
+
+  ASSERT_EQ(999, gulls.size().get());
+  ASSERT_EQ(nullptr, gulls.find(Gull::id_type{1}));
+  ASSERT_EQ(nullptr, gulls.find(Gull::id_type{900}));
+  ASSERT_EQ("late", gulls.find(Gull::id_type{5000})->name);
+  assert_gulls_intact(gulls);
+}
+
+TEST(CompactionTests, RemovingAMovedItemHandsBackAnOrdinaryUniquePtr) {
+  auto gulls = make_gulls(10);
+  gulls.compact();
+
+  std::unique_ptr< Gull > gull = gulls.remove(Gull::id_type{3});
+  ASSERT_NE(nullptr, gull);
+  ASSERT_EQ(3, gull->id().get());
+  ASSERT_EQ("gull 3", gull->name);
+  ASSERT_EQ(nullptr, gulls.by< by_name >().find("gull 3"));
+}
+
+TEST(CompactionTests, CollectionCanBeDestroyedPartWayThroughCompacting) {
+  auto gulls = std::make_unique< Gulls >(make_gulls(1000));
+  ASSERT_FALSE(gulls->compact(std::chrono::nanoseconds{0}));
+  gulls.reset();
+}
+
+TEST(CompactionTests, CollectionCanBeMovedPartWayThroughCompacting) {
+  auto gulls = make_gulls(1000);
+  ASSERT_FALSE(gulls.compact(std::chrono::nanoseconds{0}));
+
+  auto moved = std::move(gulls);
+  moved.compact();
+  ASSERT_EQ(0.0, moved.memory_usage().fragmentation);
+  assert_gulls_intact(moved);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(MemoryUsageTests, EmptyCollectionHasNoItemsOrContainers) {
+  const auto gulls = Gulls{};
+  ASSERT_EQ(0, gulls.memory_usage().items);
+  ASSERT_EQ(0, gulls.memory_usage().containers);
+  ASSERT_EQ(0.0, gulls.memory_usage().fragmentation);
+}
+
+TEST(MemoryUsageTests, AccountsForItemsContainersAndIndexes) {
+  const auto gulls = make_gulls(100);
+  const auto usage = gulls.memory_usage();
+
+  ASSERT_EQ(100 * sizeof(Gull), usage.items);
+  ASSERT_GE(usage.containers, 100 * sizeof(void*));
+  ASSERT_GT(usage.indexes, 0);
+  ASSERT_GE(usage.overhead, 100 * sizeof(size_t));
+  ASSERT_EQ(usage.items + usage.containers + usage.indexes + usage.overhead, usage.total());
+}
+
+TEST(MemoryUsageTests, CompactingGetsRidOfTheAllocatorOverhead) {
+  auto gulls = make_gulls(100);
+  gulls.compact();
+
+  ASSERT_EQ(0, gulls.memory_usage().overhead);
+
+  // A removed item goes back onto the heap on its own, but it isn't in the collection any more.
+  gulls.remove(Gull::id_type{3});
+  ASSERT_EQ(0, gulls.memory_usage().overhead);
+
+  gulls.add(Gull{100, "late", 99});
+  ASSERT_GT(gulls.memory_usage().overhead, 0);
+}
+
+TEST(MemoryUsageTests, CompactingGivesBackUnusedMemory) {
+  auto gulls = make_gulls(100);
+  for (auto i = size_t{0}; i < 50; ++i) {
+    gulls.remove(Gull::id_type{2 * i});
+  }
+
+  const auto before = gulls.memory_usage();
+  ASSERT_GT(before.unused, 0);
+
+  gulls.compact();
+
+  const auto after = gulls.memory_usage();
+  ASSERT_EQ(0, after.unused);
+  ASSERT_LT(after.total(), before.total());
+}
+
+TEST(MemoryUsageTests, RemovingCompactedItemsLeavesHolesUntilTheNextCompaction) {
+  auto gulls = make_gulls(100);
+  gulls.compact();
+  ASSERT_EQ(0, gulls.memory_usage().unused);
+
+  for (auto i = size_t{0}; i < 50; ++i) {
+    gulls.remove(Gull::id_type{2 * i});
+  }
+
+  const auto holey = gulls.memory_usage();
+  ASSERT_GE(holey.unused, 50 * sizeof(Gull));
+  ASSERT_EQ(1.0, holey.fragmentation);
+
+  gulls.compact();
+
+  ASSERT_EQ(0, gulls.memory_usage().unused);
+  ASSERT_EQ(0.0, gulls.memory_usage().fragmentation);
+  assert_gulls_intact(gulls);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
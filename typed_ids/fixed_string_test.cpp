@@ -0,0 +1,183 @@
+#include <typed/fixed_string.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/io/fixed_stringio.hpp>
+#include <typed/io/idio.hpp>
+#include <typed/key_traits.hpp>
+#include <typed/ordering.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+using Name  = typed::fixed_string< 24 >;
+using Short = typed::fixed_string< 6 >;
+
+static_assert(std::is_trivially_copyable_v< Name >);
+static_assert(std::is_trivially_copyable_v< Short >);
+
+static_assert(Name{"Cat-2022-04-27-01"}.size() == 17);
+static_assert(Name{"abc"} < Name{"abd"});
+static_assert(Name{"ab"} < Name{"abc"});
+static_assert(Name{"abc"} == Name{"abc"});
+
+static_assert(typed::packable_key< Short >);
+static_assert(std::is_same_v< uint64_t, typed::packed_key_t< Short > >);
+static_assert(std::is_same_v< uint32_t, typed::packed_key_t< typed::fixed_string< 4 > > >);
+static_assert(not typed::packable_key< Name >);
+
+struct Lynx : public typed::identifiable< Lynx, Name > {
+  explicit Lynx(Name id) : typed::identifiable< Lynx, Name >{id} {}
+};
+
+using Lynxes = typed::identifiable_item_collection< Lynx, size_t >;
+
+std::string random_string(std::mt19937& rng, size_t max_length) {
+  auto out = std::string(rng() % (max_length + 1), ' ');
+  std::generate(out.begin(), out.end(), [&rng] { return static_cast< char >('a' + rng() % 4); });
+  return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(FixedStringTests, DefaultConstructedIsEmpty) {
+  const auto str = Name{};
+  ASSERT_TRUE(str.empty());
+  ASSERT_EQ(0, str.size());
+  ASSERT_EQ("", str.view());
+}
+
+TEST(FixedStringTests, HoldsItsCharacters) {
+  const auto str = Name{std::string_view{"Cat-2022-04-27-01"}};
+  ASSERT_FALSE(str.empty());
+  ASSERT_EQ("Cat-2022-04-27-01", str.view());
+  ASSERT_TRUE(str.starts_with("Cat-2022"));
+  ASSERT_FALSE(str.starts_with("Dog"));
+}
+
+TEST(FixedStringTests, CanBeFilledToCapacity) {
+  const auto str = Short{"abcdef"};
+  ASSERT_EQ(6, str.size());
+  ASSERT_EQ("abcdef", str.view());
+}
+
+TEST(FixedStringTests, ThrowsIfTooLong) {
+  ASSERT_THROW(Short{std::string_view{"abcdefg"}}, std::length_error);
+}
+
+TEST(FixedStringTests, ThrowsIfItWouldContainANul) {
+  using namespace std::string_view_literals;
+  ASSERT_THROW(Short{"ab\0cd"sv}, std::invalid_argument);
+  ASSERT_THROW(Short{"\0"sv}, std::invalid_argument);
+}
+
+TEST(FixedStringTests, ArraysStopAtTheFirstNul) {
+  const char chars[] = {'a', 'b', '\0', 'x', 'y', '\0'};
+  const auto str     = Short{chars};
+
+  ASSERT_EQ(2, str.size());
+  ASSERT_EQ("ab", str.view());
+
+  // Nothing after the '\0' is kept, so it's the same string in every way, not just in its characters.
+  ASSERT_EQ(Short{"ab"}, str);
+  ASSERT_EQ(std::hash< Short >{}(Short{"ab"}), std::hash< Short >{}(str));
+  ASSERT_EQ(typed::pack_key(Short{"ab"}), typed::pack_key(str));
+  ASSERT_EQ(0, std::memcmp(Short{"ab"}.data(), str.data(), Short::max_size()));
+}
+
+TEST(FixedStringTests, LiteralsThatAreTooLongDontCompile) {
+  static_assert(std::constructible_from< Short, const char(&)[7] >);
+  static_assert(not std::constructible_from< Short, const char(&)[8] >);
+  static_assert(not std::convertible_to< const char(&)[8], Short >);
+  static_assert(not std::constructible_from< typed::fixed_string< 4 >, const char(&)[7] >);
+  static_assert(std::constructible_from< Lynx::id_type, const char(&)[25] >);
+  static_assert(not std::constructible_from< Lynx::id_type, const char(&)[26] >);
+}
+
+TEST(FixedStringTests, OrdersAndComparesLikeStdString) {
+  auto rng = std::mt19937{11};
+  for (auto i = 0; i < 10'000; ++i) {
+    const auto l = random_string(rng, 24);
+    const auto r = random_string(rng, 24);
+
+    ASSERT_EQ(l == r, Name{l} == Name{r}) << l << " vs. " << r;
+    ASSERT_EQ(l < r, Name{l} < Name{r}) << l << " vs. " << r;
+    ASSERT_EQ(l > r, Name{l} > Name{r}) << l << " vs. " << r;
+  }
+}
+
+TEST(FixedStringTests, PackedKeysOrderLikeTheStrings) {
+  auto rng = std::mt19937{12};
+  for (auto i = 0; i < 10'000; ++i) {
+    const auto l = Short{random_string(rng, 6)};
+    const auto r = Short{random_string(rng, 6)};
+
+    ASSERT_EQ(l < r, typed::pack_key(l) < typed::pack_key(r));
+    ASSERT_EQ(l == r, typed::pack_key(l) == typed::pack_key(r));
+  }
+}
+
+TEST(FixedStringTests, EqualStringsHashTheSame) {
+  ASSERT_EQ(Name{"Cat-01"}.hash(), Name{std::string_view{"Cat-01"}}.hash());
+  ASSERT_EQ(std::hash< Name >{}(Name{"Cat-01"}), typed::key_hash< Name >{}(Name{"Cat-01"}));
+
+  auto hashes = std::unordered_set< size_t >{};
+  for (auto i = 0; i < 1'000; ++i) {
+    hashes.insert(Name{std::string_view{"Cat-" + std::to_string(i)}}.hash());
+  }
+
+  ASSERT_EQ(1'000, hashes.size());
+}
+
+TEST(FixedStringTests, StreamsThroughIdio) {
+  auto out = std::ostringstream{};
+  out << Lynx::id_type{"Cat-2022-04-27-01"};
+  ASSERT_EQ("Cat-2022-04-27-01", out.str());
+
+  auto in = std::istringstream{"lynx-1 this-one-is-far-too-long-for-a-name"};
+  auto id = Lynx::id_type{};
+  ASSERT_TRUE(in >> id);
+  ASSERT_EQ(Lynx::id_type{"lynx-1"}, id);
+  ASSERT_FALSE(in >> id);
+  ASSERT_EQ(Lynx::id_type{"lynx-1"}, id);
+}
+
+TEST(FixedStringTests, ReadingAWordWithANulFails) {
+  using namespace std::string_literals;
+  auto in = std::istringstream{"ly\0nx"s};
+  auto id = Lynx::id_type{};
+  ASSERT_FALSE(in >> id);
+  ASSERT_EQ(Lynx::id_type{}, id);
+}
+
+TEST(FixedStringTests, WorksAsACollectionId) {
+  auto lynxes = Lynxes{};
+  lynxes.add(Lynx{"lynx-c"});
+  lynxes.add(Lynx{"lynx-a"});
+  lynxes.add(Lynx{"lynx-b"});
+  ASSERT_FALSE(lynxes.add(Lynx{"lynx-a"}).second);
+
+  ASSERT_NE(nullptr, lynxes.find(Lynx::id_type{"lynx-b"}));
+  ASSERT_EQ(nullptr, lynxes.find(Lynx::id_type{"lynx-d"}));
+
+  typed::sort_by_id(lynxes);
+  ASSERT_TRUE(typed::is_sorted_by_id(lynxes));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
@@ -3,7 +3,13 @@
 #include <typed/identifiable.hpp>
 #include <typed/io/idio.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <string>
+#include <thread>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -123,6 +129,324 @@ TEST_F(IdentifiableItemCollectionTests, EmplaceAnItem) {
   ASSERT_EQ(Duck::id_type{"duck-0"}, d_find->id());
 }
 
+TEST_F(IdentifiableItemCollectionTests, FindManyReturnsItemsInInputOrder) {
+  ducks.add(Duck{"duck-001"});
+  ducks.add(Duck{"duck-002"});
+  ducks.add(Duck{"duck-003"});
+
+  const auto ids = std::array{Duck::id_type{"duck-003"}, Duck::id_type{"duck-001"}, Duck::id_type{"duck-002"}};
+  auto found     = std::array< Duck*, 3 >{};
+  ducks.find_many(ids, found);
+
+  for (auto i = 0u; i < ids.size(); ++i) {
+    ASSERT_NE(nullptr, found[i]);
+    ASSERT_EQ(ids[i], found[i]->id());
+  }
+}
+
+TEST_F(IdentifiableItemCollectionTests, FindManyReturnsNullForMissingItems) {
+  ducks.add(Duck{"duck-001"});
+  ducks.add(Duck{"duck-002"});
+
+  const auto ids = std::array{Duck::id_type{"duck-000"}, Duck::id_type{"duck-002"}, Duck::id_type{"duck-003"}};
+  auto found     = std::array< const Duck*, 3 >{};
+  std::as_const(ducks).find_many(ids, found);
+
+  ASSERT_EQ(nullptr, found[0]);
+  ASSERT_EQ(ducks.find(Duck::id_type{"duck-002"}), found[1]);
+  ASSERT_EQ(nullptr, found[2]);
+}
+
+TEST_F(IdentifiableItemCollectionTests, FindManyResolvesRepeatedIds) {
+  ducks.add(Duck{"duck-001"});
+  ducks.add(Duck{"duck-002"});
+
+  const auto ids = std::array{Duck::id_type{"duck-002"}, Duck::id_type{"duck-001"}, Duck::id_type{"duck-002"}};
+  auto found     = std::array< Duck*, 3 >{};
+  ducks.find_many(ids, found);
+
+  ASSERT_EQ(ducks.find(Duck::id_type{"duck-002"}), found[0]);
+  ASSERT_EQ(ducks.find(Duck::id_type{"duck-001"}), found[1]);
+  ASSERT_EQ(ducks.find(Duck::id_type{"duck-002"}), found[2]);
+}
+
+TEST(IdentifiableItemCollectionFindManyTests, LargeBatchIsResolvedInInputOrder) {
+  using ManyDucks = typed::identifiable_item_collection< Duck, size_t >;
+
+  auto ducks = ManyDucks{};
+  auto ids   = std::vector< Duck::id_type >{};
+  for (auto i = 0; i < 1000; ++i) {
+    ids.push_back(ducks.add(Duck{"duck-" + std::to_string(i)}).first->id());
+  }
+
+  std::reverse(ids.begin(), ids.end());
+  ids.push_back(Duck::id_type{"not-a-duck"});
+  ids.push_back(ids.front());
+
+  auto found = std::vector< Duck* >(ids.size());
+  ducks.find_many(ids, found);
+
+  for (auto i = 0u; i < ids.size() - 2; ++i) {
+    ASSERT_EQ(ducks.find(ids[i]), found[i]);
+    ASSERT_EQ(ids[i], found[i]->id());
+  }
+
+  ASSERT_EQ(nullptr, found[ids.size() - 2]);
+  ASSERT_EQ(found.front(), found.back());
+}
+
+TEST(IdentifiableItemCollectionPackedIdTests, FindAfterRemove) {
+  struct Drake : public typed::identifiable< Drake, uint32_t > {
+    Drake(uint32_t id) : typed::identifiable< Drake, uint32_t >{id} {}
+  };
+
+  auto drakes = typed::identifiable_item_collection< Drake, size_t >{};
+  for (auto i = 0u; i < 100; ++i) {
+    drakes.add(Drake{i * 3});
+  }
+
+  ASSERT_NE(nullptr, drakes.remove(Drake::id_type{30}));
+  ASSERT_EQ(nullptr, drakes.find(Drake::id_type{30}));
+  ASSERT_EQ(Drake::id_type{33}, drakes.find(Drake::id_type{33})->id());
+  ASSERT_EQ(Drake::id_type{297}, drakes.find(Drake::id_type{297})->id());
+  ASSERT_FALSE(drakes.add(Drake{297}).second);
+  ASSERT_TRUE(drakes.add(Drake{30}).second);
+}
+
+TEST(IdentifiableItemCollectionPackedIdTests, FindManyWithLargeBatch) {
+  struct Drake : public typed::identifiable< Drake, uint32_t > {
+    Drake(uint32_t id) : typed::identifiable< Drake, uint32_t >{id} {}
+  };
+
+  auto drakes = typed::identifiable_item_collection< Drake, size_t >{};
+  auto ids    = std::vector< Drake::id_type >{};
+  for (auto i = 0u; i < 1000; ++i) {
+    drakes.add(Drake{i * 7});
+    ids.push_back(Drake::id_type{(999 - i) * 7 + (i % 3 == 0 ? 1 : 0)});
+  }
+
+  auto found = std::vector< Drake* >(ids.size());
+  drakes.find_many(ids, found);
+
+  for (auto i = 0u; i < ids.size(); ++i) {
+    ASSERT_EQ(drakes.find(ids[i]), found[i]);
+  }
+}
+
+TEST_F(IdentifiableItemCollectionTests, FindManyOnEmptyCollectionReturnsAllNull) {
+  const auto ids = std::array{Duck::id_type{"duck-001"}, Duck::id_type{"duck-002"}};
+  auto found     = std::array< Duck*, 2 >{reinterpret_cast< Duck* >(1), reinterpret_cast< Duck* >(1)};
+  ducks.find_many(ids, found);
+
+  ASSERT_EQ(nullptr, found[0]);
+  ASSERT_EQ(nullptr, found[1]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_F(IdentifiableItemCollectionTests, IndexIsNotBuiltUntilTheFirstFind) {
+  ducks.add(Duck{"duck-001"});
+  ducks.add(Duck{"duck-002"});
+  ASSERT_FALSE(ducks.index_state().built);
+
+  ASSERT_NE(nullptr, ducks.find(Duck::id_type{"duck-002"}));
+
+  const auto state = ducks.index_state();
+  ASSERT_TRUE(state.built);
+  ASSERT_EQ(Ducks::size_type{2}, state.indexed);
+  ASSERT_EQ(Ducks::size_type{0}, state.pending);
+}
+
+TEST_F(IdentifiableItemCollectionTests, ConstFindDoesNotBuildTheIndex) {
+  ducks.add(Duck{"duck-001"});
+
+  ASSERT_NE(nullptr, std::as_const(ducks).find(Duck::id_type{"duck-001"}));
+  ASSERT_FALSE(ducks.index_state().built);
+}
+
+TEST_F(IdentifiableItemCollectionTests, AddsAfterTheIndexIsBuiltArePending) {
+  ducks.add(Duck{"duck-001"});
+  ducks.build_index();
+  ducks.add(Duck{"duck-002"});
+
+  const auto state = ducks.index_state();
+  ASSERT_EQ(Ducks::size_type{1}, state.indexed);
+  ASSERT_EQ(Ducks::size_type{1}, state.pending);
+  ASSERT_NE(nullptr, std::as_const(ducks).find(Duck::id_type{"duck-002"}));
+  ASSERT_FALSE(ducks.add(Duck{"duck-002"}).second);
+
+  ducks.build_index();
+  ASSERT_EQ(Ducks::size_type{2}, ducks.index_state().indexed);
+  ASSERT_EQ(Ducks::size_type{0}, ducks.index_state().pending);
+}
+
+TEST_F(IdentifiableItemCollectionTests, DropIndex) {
+  ducks.add(Duck{"duck-001"});
+  ducks.build_index();
+  ducks.drop_index();
+
+  ASSERT_FALSE(ducks.index_state().built);
+  ASSERT_NE(nullptr, std::as_const(ducks).find(Duck::id_type{"duck-001"}));
+}
+
+TEST(IdentifiableItemCollectionIndexTests, PendingItemsAreMergedInBatches) {
+  using ManyDucks = typed::identifiable_item_collection< Duck, size_t >;
+
+  auto ducks = ManyDucks{};
+  ducks.build_index();
+  for (auto i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(ducks.add(Duck{"duck-" + std::to_string(i)}).second);
+    ASSERT_FALSE(ducks.add(Duck{"duck-" + std::to_string(i / 2)}).second);
+  }
+
+  const auto state = ducks.index_state();
+  ASSERT_GT(state.indexed, state.pending);
+  ASSERT_EQ(ducks.size(), state.indexed + state.pending);
+
+  for (auto i = 0; i < 1000; ++i) {
+    ASSERT_NE(nullptr, std::as_const(ducks).find(Duck::id_type{"duck-" + std::to_string(i)}));
+  }
+}
+
+TEST(IdentifiableItemCollectionIndexTests, PendingItemsStayFewInAnyOrder) {
+  struct Teal : public typed::identifiable< Teal, uint32_t > {
+    Teal(uint32_t id) : typed::identifiable< Teal, uint32_t >{id} {}
+  };
+
+  auto teals = typed::identifiable_item_collection< Teal, size_t >{};
+  teals.build_index();
+  for (auto i = 0u; i < 20'000; ++i) {
+    ASSERT_TRUE(teals.add(Teal{(i * 7919u) % 20'000u}).second);
+
+    const auto state = teals.index_state();
+    ASSERT_LE(state.pending.get(), std::max< size_t >(32, 1 + static_cast< size_t >(std::sqrt(state.indexed.get()))));
+  }
+
+  for (auto i = 0u; i < 20'000; ++i) {
+    ASSERT_EQ(Teal::id_type{i}, std::as_const(teals).find(Teal::id_type{i})->id());
+  }
+}
+
+TEST(IdentifiableItemCollectionIndexTests, ConcurrentNonConstFindsShareTheIndexBuild) {
+  using ManyDucks = typed::identifiable_item_collection< Duck, size_t >;
+
+  auto ducks = ManyDucks{};
+  for (auto i = 0; i < 2000; ++i) {
+    ducks.add(Duck{"duck-" + std::to_string(i)});
+  }
+
+  auto misses  = std::atomic< int >{0};
+  auto readers = std::vector< std::thread >{};
+  for (auto t = 0; t < 8; ++t) {
+    readers.emplace_back([&ducks, &misses, t] {
+      for (auto i = t; i < 2000; i += 3) {
+        const auto id = Duck::id_type{"duck-" + std::to_string(i)};
+        misses += nullptr == ducks.find(id) ? 1 : 0;
+
+        auto found = std::array< Duck*, 1 >{};
+        ducks.find_many(std::span{&id, 1}, found);
+        misses += nullptr == found[0] ? 1 : 0;
+      }
+    });
+  }
+
+  for (auto&& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(0, misses);
+  ASSERT_TRUE(ducks.index_state().built);
+  ASSERT_EQ(ducks.size(), ducks.index_state().indexed);
+}
+
+TEST(IdentifiableItemCollectionIndexTests, RemoveKeepsTheIndexInStep) {
+  struct Teal : public typed::identifiable< Teal, uint32_t > {
+    Teal(uint32_t id) : typed::identifiable< Teal, uint32_t >{id} {}
+  };
+
+  auto teals = typed::identifiable_item_collection< Teal, size_t >{};
+  for (auto i = 0u; i < 500; ++i) {
+    teals.add(Teal{i});
+  }
+
+  teals.build_index();
+  for (auto i = 500u; i < 510; ++i) {
+    teals.add(Teal{i});
+  }
+
+  ASSERT_NE(nullptr, teals.remove(Teal::id_type{10}));
+  ASSERT_NE(nullptr, teals.remove(Teal::id_type{505}));
+  ASSERT_NE(nullptr, teals.remove(Teal::id_type{0}));
+
+  for (auto i = 0u; i < 510; ++i) {
+    const auto teal = std::as_const(teals).find(Teal::id_type{i});
+    if (0 == i or 10 == i or 505 == i) {
+      ASSERT_EQ(nullptr, teal);
+    } else {
+      ASSERT_NE(nullptr, teal);
+      ASSERT_EQ(Teal::id_type{i}, teal->id());
+    }
+  }
+
+  for (auto i = decltype(teals)::index_type{0}; i < teals.size(); ++i) {
+    const auto& teal = teals.at(i);
+    ASSERT_EQ(&teal, teals.find(teal.id()));
+  }
+}
+
+TEST(IdentifiableItemCollectionIndexTests, FindManyWithAnIndex) {
+  using ManyDucks = typed::identifiable_item_collection< Duck, size_t >;
+
+  auto ducks = ManyDucks{};
+  auto ids   = std::vector< Duck::id_type >{};
+  for (auto i = 0; i < 700; ++i) {
+    ducks.add(Duck{"duck-" + std::to_string(i)});
+    ids.push_back(Duck::id_type{"duck-" + std::to_string((i * 13) % 750)});
+  }
+
+  ducks.build_index();
+  ducks.add(Duck{"duck-740"});
+
+  auto found = std::vector< const Duck* >(ids.size());
+  std::as_const(ducks).find_many(ids, found);
+
+  for (auto i = 0u; i < ids.size(); ++i) {
+    ASSERT_EQ(std::as_const(ducks).find(ids[i]), found[i]);
+  }
+}
+
+TEST(IdentifiableItemCollectionIndexTests, FindManyWithABigIndexSearchesInLockStep) {
+  struct Teal : public typed::identifiable< Teal, uint32_t > {
+    Teal(uint32_t id) : typed::identifiable< Teal, uint32_t >{id} {}
+  };
+
+  // Enough items for the index not to fit in cache, which is when find_many interleaves its searches.
+  constexpr auto item_count = 600'000u;
+
+  auto teals = typed::identifiable_item_collection< Teal, size_t >{};
+  teals.build_index();
+  for (auto i = 0u; i < item_count; ++i) {
+    teals.add(Teal{static_cast< uint32_t >(uint64_t{i} * 7919u % item_count * 2)});
+  }
+
+  auto ids = std::vector< Teal::id_type >{};
+  for (auto i = 0u; i < 1000; ++i) {
+    ids.push_back(Teal::id_type{i * 1201u % (2 * item_count)});
+  }
+
+  auto found = std::vector< const Teal* >(ids.size());
+  std::as_const(teals).find_many(ids, found);
+
+  for (auto i = 0u; i < ids.size(); ++i) {
+    if (0 == ids[i].get() % 2) {
+      ASSERT_NE(nullptr, found[i]);
+      ASSERT_EQ(ids[i], found[i]->id());
+    } else {
+      ASSERT_EQ(nullptr, found[i]);
+    }
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }  // namespace
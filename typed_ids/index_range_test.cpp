@@ -0,0 +1,86 @@
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/index_range.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Puffin : public typed::identifiable< Puffin, size_t > {
+  explicit Puffin(size_t id) : typed::identifiable< Puffin, size_t >{id} {}
+};
+
+using Puffins = typed::identifiable_item_collection< Puffin, uint16_t >;
+using Range   = typed::index_range< Puffins::index_type >;
+
+static_assert(std::random_access_iterator< Range::iterator >);
+
+Range make_range(uint16_t first, uint16_t last) {
+  return Range{Puffins::index_type{first}, Puffins::index_type{last}};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(IndexRangeTests, DefaultConstructedIsEmpty) {
+  const auto range = Range{};
+  ASSERT_TRUE(range.empty());
+  ASSERT_EQ(0, range.size());
+  ASSERT_EQ(range.begin(), range.end());
+}
+
+TEST(IndexRangeTests, IteratesOverTypedIndices) {
+  auto visited = std::vector< Puffins::index_type >{};
+  for (auto idx : make_range(3, 7)) {
+    visited.push_back(idx);
+  }
+
+  ASSERT_EQ(4, visited.size());
+  ASSERT_EQ(Puffins::index_type{3}, visited.front());
+  ASSERT_EQ(Puffins::index_type{6}, visited.back());
+  ASSERT_EQ(4, std::distance(make_range(3, 7).begin(), make_range(3, 7).end()));
+}
+
+TEST(IndexRangeTests, BackwardsRangeIsEmpty) {
+  ASSERT_TRUE(make_range(7, 3).empty());
+}
+
+TEST(IndexRangeTests, SplitGivesTwoHalvesThatCoverTheRange) {
+  auto first        = make_range(10, 21);
+  const auto second = first.split();
+
+  ASSERT_EQ(make_range(10, 15), first);
+  ASSERT_EQ(make_range(15, 21), second);
+}
+
+TEST(IndexRangeTests, TakeFrontSplitsOffAChunk) {
+  auto range       = make_range(0, 10);
+  const auto chunk = range.take_front(4);
+
+  ASSERT_EQ(make_range(0, 4), chunk);
+  ASSERT_EQ(make_range(4, 10), range);
+  ASSERT_EQ(make_range(4, 10), range.take_front(100));
+  ASSERT_TRUE(range.empty());
+}
+
+TEST(IndexRangeTests, IndicesCoverTheCollection) {
+  auto puffins = Puffins{};
+  puffins.add(Puffin{1});
+  puffins.add(Puffin{2});
+  puffins.add(Puffin{3});
+
+  const auto range = typed::indices(puffins);
+  ASSERT_EQ(make_range(0, 3), range);
+  ASSERT_EQ(Puffin::id_type{3}, puffins.at(range.back()).id());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
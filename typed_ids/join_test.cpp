@@ -0,0 +1,178 @@
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/join.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Goose : public typed::identifiable< Goose, uint32_t > {
+  explicit Goose(uint32_t id) : typed::identifiable< Goose, uint32_t >{id} {}
+};
+
+using Geese = typed::identifiable_item_collection< Goose, size_t >;
+
+struct Swan : public typed::identifiable< Swan, std::string > {
+  explicit Swan(std::string id) : typed::identifiable< Swan, std::string >{std::move(id)} {}
+};
+
+using Swans = typed::identifiable_item_collection< Swan, size_t >;
+
+struct Keeper : public typed::identifiable< Keeper, size_t > {
+  Keeper(size_t id, Goose::id_type favourite, std::vector< Goose::id_type > geese = {}, std::string swan = {})
+      : typed::identifiable< Keeper, size_t >{id}
+      , favourite{favourite}
+      , geese{std::move(geese)}
+      , swan{std::move(swan)} {}
+
+  [[nodiscard]] Swan::id_type swan_id() const { return Swan::id_type{swan}; }
+
+  Goose::id_type favourite;
+  std::vector< Goose::id_type > geese;
+  std::string swan;
+};
+
+using Keepers = typed::identifiable_item_collection< Keeper, size_t >;
+
+const auto strategies = {typed::join_strategy::automatic, typed::join_strategy::hash, typed::join_strategy::sort_merge};
+
+Geese make_geese(uint32_t count) {
+  auto geese = Geese{};
+  for (auto i = uint32_t{0}; i < count; ++i) {
+    geese.add(Goose{i * 10});
+  }
+
+  return geese;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(JoinTests, SingleReferencesResolveToTheirTargets) {
+  const auto geese = make_geese(5);
+
+  auto keepers = Keepers{};
+  keepers.add(Keeper{1, Goose::id_type{30}});
+  keepers.add(Keeper{2, Goose::id_type{0}});
+  keepers.add(Keeper{3, Goose::id_type{35}});
+  keepers.add(Keeper{4, Goose::id_type{30}});
+
+  for (auto strategy : strategies) {
+    const auto favourites = typed::join(keepers, &Keeper::favourite, geese, strategy);
+
+    ASSERT_EQ(keepers.size(), favourites.size());
+    ASSERT_EQ(geese.find(Goose::id_type{30}), favourites[Keepers::index_type{0}]);
+    ASSERT_EQ(geese.find(Goose::id_type{0}), favourites[Keepers::index_type{1}]);
+    ASSERT_EQ(nullptr, favourites[Keepers::index_type{2}]);
+    ASSERT_EQ(geese.find(Goose::id_type{30}), favourites[Keepers::index_type{3}]);
+    ASSERT_EQ(1, favourites.unresolved());
+  }
+}
+
+TEST(JoinTests, RangesOfReferencesResolveInOrder) {
+  const auto geese = make_geese(5);
+
+  auto keepers = Keepers{};
+  keepers.add(Keeper{1, Goose::id_type{0}, {Goose::id_type{40}, Goose::id_type{10}}});
+  keepers.add(Keeper{2, Goose::id_type{0}, {}});
+  keepers.add(Keeper{3, Goose::id_type{0}, {Goose::id_type{99}, Goose::id_type{10}, Goose::id_type{20}}});
+
+  for (auto strategy : strategies) {
+    const auto owned = typed::join(keepers, &Keeper::geese, geese, strategy);
+
+    ASSERT_EQ(keepers.size(), owned.size());
+
+    const auto first = owned[Keepers::index_type{0}];
+    ASSERT_EQ(2, first.size());
+    ASSERT_EQ(Goose::id_type{40}, first[0]->id());
+    ASSERT_EQ(Goose::id_type{10}, first[1]->id());
+
+    ASSERT_TRUE(owned[Keepers::index_type{1}].empty());
+
+    const auto third = owned[Keepers::index_type{2}];
+    ASSERT_EQ(3, third.size());
+    ASSERT_EQ(nullptr, third[0]);
+    ASSERT_EQ(Goose::id_type{10}, third[1]->id());
+    ASSERT_EQ(Goose::id_type{20}, third[2]->id());
+
+    ASSERT_EQ(1, owned.unresolved());
+  }
+}
+
+TEST(JoinTests, ProjectionsCanReturnIdsByValue) {
+  auto swans = Swans{};
+  swans.add(Swan{"mute"});
+  swans.add(Swan{"whooper"});
+
+  auto keepers = Keepers{};
+  keepers.add(Keeper{1, Goose::id_type{0}, {}, "whooper"});
+  keepers.add(Keeper{2, Goose::id_type{0}, {}, "trumpeter"});
+  keepers.add(Keeper{3, Goose::id_type{0}, {}, "mute"});
+
+  for (auto strategy : strategies) {
+    const auto cared_for = typed::join(keepers, &Keeper::swan_id, swans, strategy);
+
+    ASSERT_EQ(Swan::id_type{"whooper"}, cared_for[Keepers::index_type{0}]->id());
+    ASSERT_EQ(nullptr, cared_for[Keepers::index_type{1}]);
+    ASSERT_EQ(Swan::id_type{"mute"}, cared_for[Keepers::index_type{2}]->id());
+  }
+}
+
+TEST(JoinTests, EmptyTargetLeavesEverythingUnresolved) {
+  auto keepers = Keepers{};
+  keepers.add(Keeper{1, Goose::id_type{0}});
+
+  const auto favourites = typed::join(keepers, &Keeper::favourite, Geese{});
+  ASSERT_EQ(nullptr, favourites[Keepers::index_type{0}]);
+  ASSERT_EQ(1, favourites.unresolved());
+}
+
+TEST(JoinTests, AllStrategiesAgreeOnLargeCollections) {
+  const auto geese = make_geese(40'000);
+
+  auto rng     = std::mt19937{3};
+  auto keepers = Keepers{};
+  for (auto i = size_t{0}; i < 30'000; ++i) {
+    keepers.add(Keeper{i, Goose::id_type{static_cast< uint32_t >(rng() % 500'000)}});
+  }
+
+  const auto automatic  = typed::join(keepers, &Keeper::favourite, geese);
+  const auto hashed     = typed::join(keepers, &Keeper::favourite, geese, typed::join_strategy::hash);
+  const auto sort_merge = typed::join(keepers, &Keeper::favourite, geese, typed::join_strategy::sort_merge);
+
+  for (auto i = Keepers::index_type{0}; i < keepers.size(); ++i) {
+    const auto expected = geese.find(keepers.at(i).favourite);
+    ASSERT_EQ(expected, automatic[i]);
+    ASSERT_EQ(expected, hashed[i]);
+    ASSERT_EQ(expected, sort_merge[i]);
+  }
+
+  ASSERT_EQ(hashed.unresolved(), sort_merge.unresolved());
+}
+
+template < typename Source_C, typename Projection_T, typename Target_C >
+concept can_join = requires(const Source_C& source, Projection_T projection, const Target_C& target) {
+  typed::join(source, projection, target);
+};
+
+TEST(JoinTests, JoinsNeedTheRightIdType) {
+  static_assert(can_join< Keepers, decltype(&Keeper::favourite), Geese >);
+  static_assert(can_join< Keepers, decltype(&Keeper::geese), Geese >);
+  static_assert(can_join< Keepers, decltype(&Keeper::swan_id), Swans >);
+
+  // A keeper's favourite is a goose, not a swan, and the swan's name on its own isn't a swan's ID.
+  static_assert(not can_join< Keepers, decltype(&Keeper::favourite), Swans >);
+  static_assert(not can_join< Keepers, decltype(&Keeper::geese), Swans >);
+  static_assert(not can_join< Keepers, decltype(&Keeper::swan), Swans >);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,101 @@
+#include <typed/id.hpp>
+#include <typed/key_traits.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Version {
+  uint8_t major;
+  uint8_t minor;
+
+  auto operator<=>(const Version&) const = default;
+};
+
+enum class Colour : int8_t { red = -1, green = 0, blue = 1 };
+
+struct Tortoise {};
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <>
+struct typed::key_traits< Version > {
+  using key_type = uint16_t;
+
+  static constexpr key_type pack(const Version& v) noexcept { return static_cast< key_type >((v.major << 8) | v.minor); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(KeyTraitsTests, BuiltInTypesArePackable) {
+  static_assert(typed::packable_key< uint8_t >);
+  static_assert(typed::packable_key< size_t >);
+  static_assert(typed::packable_key< int >);
+  static_assert(typed::packable_key< Colour >);
+  static_assert(typed::packable_key< typed::id< Tortoise, size_t > >);
+  static_assert(typed::packable_key< Version >);
+  static_assert(typed::packable_key< typed::id< Tortoise, Version > >);
+}
+
+TEST(KeyTraitsTests, OtherTypesAreNotPackable) {
+  static_assert(not typed::packable_key< bool >);
+  static_assert(not typed::packable_key< double >);
+  static_assert(not typed::packable_key< std::string >);
+  static_assert(not typed::packable_key< typed::id< Tortoise, std::string > >);
+}
+
+TEST(KeyTraitsTests, UnsignedValuesPackToThemselves) {
+  ASSERT_EQ(uint32_t{12345}, typed::pack_key(uint32_t{12345}));
+}
+
+TEST(KeyTraitsTests, SignedValuesKeepTheirOrder) {
+  ASSERT_LT(typed::pack_key(-100), typed::pack_key(-1));
+  ASSERT_LT(typed::pack_key(-1), typed::pack_key(0));
+  ASSERT_LT(typed::pack_key(0), typed::pack_key(1));
+  ASSERT_LT(typed::pack_key(INT32_MIN), typed::pack_key(INT32_MAX));
+}
+
+TEST(KeyTraitsTests, EnumsPackAsTheirUnderlyingType) {
+  ASSERT_LT(typed::pack_key(Colour::red), typed::pack_key(Colour::green));
+  ASSERT_LT(typed::pack_key(Colour::green), typed::pack_key(Colour::blue));
+}
+
+TEST(KeyTraitsTests, IdsPackAsTheirValue) {
+  using TortoiseId = typed::id< Tortoise, Version >;
+  ASSERT_EQ(typed::pack_key(Version{1, 2}), typed::pack_key(TortoiseId{Version{1, 2}}));
+}
+
+TEST(KeyTraitsTests, CustomPackingKeepsTheOrder) {
+  const auto a = Version{1, 9};
+  const auto b = Version{2, 0};
+  ASSERT_LT(a, b);
+  ASSERT_LT(typed::pack_key(a), typed::pack_key(b));
+}
+
+TEST(KeyTraitsTests, EqualValuesHaveEqualHashes) {
+  using TortoiseId = typed::id< Tortoise, size_t >;
+  ASSERT_EQ(typed::key_hash< TortoiseId >{}(TortoiseId{42}), typed::key_hash< TortoiseId >{}(TortoiseId{42}));
+  ASSERT_NE(typed::key_hash< TortoiseId >{}(TortoiseId{42}), typed::key_hash< TortoiseId >{}(TortoiseId{43}));
+}
+
+TEST(KeyTraitsTests, UnpackableIdsAreHashedByValue) {
+  using TortoiseId = typed::id< Tortoise, std::string >;
+  ASSERT_EQ(std::hash< std::string >{}("shell"), typed::key_hash< TortoiseId >{}(TortoiseId{"shell"}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
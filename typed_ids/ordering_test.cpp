@@ -0,0 +1,111 @@
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/ordering.hpp>
+
+#include <random>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Owl : public typed::identifiable< Owl, int > {
+  Owl(int id, int tree = 0) : typed::identifiable< Owl, int >{id}, tree{tree} {}
+
+  int tree;
+};
+
+using Owls = typed::identifiable_item_collection< Owl, size_t >;
+
+struct Wren : public typed::identifiable< Wren, std::string > {
+  explicit Wren(std::string id) : typed::identifiable< Wren, std::string >{std::move(id)} {}
+};
+
+using Wrens = typed::identifiable_item_collection< Wren, size_t >;
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(OrderingTests, EmptyCollectionIsSorted) {
+  auto owls = Owls{};
+  typed::sort_by_id(owls);
+  ASSERT_TRUE(typed::is_sorted_by_id(owls));
+}
+
+TEST(OrderingTests, SortByPackedId) {
+  auto rng  = std::mt19937{7};
+  auto owls = Owls{};
+  for (auto i = 0; i < 1000; ++i) {
+    owls.add(Owl{static_cast< int >(rng() % 100'000) - 50'000});
+  }
+
+  const auto count = owls.size();
+  ASSERT_FALSE(typed::is_sorted_by_id(owls));
+
+  typed::sort_by_id(owls);
+
+  ASSERT_EQ(count, owls.size());
+  ASSERT_TRUE(typed::is_sorted_by_id(owls));
+}
+
+TEST(OrderingTests, SortedCollectionCanStillFindItems) {
+  auto owls = Owls{};
+  owls.add(Owl{3});
+  owls.add(Owl{-1});
+  owls.add(Owl{2});
+
+  typed::sort_by_id(owls);
+
+  ASSERT_EQ(Owl::id_type{-1}, owls.at(Owls::index_type{0}).id());
+  ASSERT_EQ(Owl::id_type{3}, owls.find(Owl::id_type{3})->id());
+  ASSERT_EQ(nullptr, owls.find(Owl::id_type{4}));
+}
+
+TEST(OrderingTests, SortByUnpackableId) {
+  auto wrens = Wrens{};
+  wrens.add(Wren{"wren-c"});
+  wrens.add(Wren{"wren-a"});
+  wrens.add(Wren{"wren-b"});
+
+  typed::sort_by_id(wrens);
+
+  ASSERT_TRUE(typed::is_sorted_by_id(wrens));
+  ASSERT_EQ(Wren::id_type{"wren-a"}, wrens.at(Wrens::index_type{0}).id());
+}
+
+TEST(OrderingTests, MergeKeepsTheOrderAndPrefersTheFirstCollection) {
+  auto first = Owls{};
+  first.add(Owl{1, 1});
+  first.add(Owl{4, 1});
+  first.add(Owl{6, 1});
+
+  auto second = Owls{};
+  second.add(Owl{2, 2});
+  second.add(Owl{4, 2});
+  second.add(Owl{9, 2});
+
+  const auto owls = typed::merge_by_id(std::move(first), std::move(second));
+
+  ASSERT_EQ(Owls::size_type{5}, owls.size());
+  ASSERT_TRUE(typed::is_sorted_by_id(owls));
+  ASSERT_EQ(1, owls.find(Owl::id_type{4})->tree);
+  ASSERT_EQ(2, owls.find(Owl::id_type{9})->tree);
+}
+
+TEST(OrderingTests, MergeWithAnEmptyCollection) {
+  auto wrens = Wrens{};
+  wrens.add(Wren{"wren-a"});
+  wrens.add(Wren{"wren-b"});
+
+  const auto merged = typed::merge_by_id(Wrens{}, std::move(wrens));
+
+  ASSERT_EQ(Wrens::size_type{2}, merged.size());
+  ASSERT_TRUE(typed::is_sorted_by_id(merged));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
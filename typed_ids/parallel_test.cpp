@@ -0,0 +1,241 @@
+#include <typed/detail/work_stealing_pool.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/index_range.hpp>
+#include <typed/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Gannet : public typed::identifiable< Gannet, size_t > {
+  explicit Gannet(size_t id) : typed::identifiable< Gannet, size_t >{id} {}
+
+  size_t dives{0};
+};
+
+using Gannets = typed::identifiable_item_collection< Gannet, size_t >;
+using Range   = typed::index_range< Gannets::index_type >;
+
+struct Puffin : public typed::identifiable< Puffin, size_t > {
+  explicit Puffin(size_t id) : typed::identifiable< Puffin, size_t >{id} {}
+};
+
+using Puffins = typed::identifiable_item_collection< Puffin, size_t >;
+
+Gannets make_gannets(size_t count) {
+  auto gannets = Gannets{};
+  gannets.build_index();
+  for (auto i = size_t{0}; i < count; ++i) {
+    gannets.add(Gannet{i});
+  }
+
+  return gannets;
+}
+
+Range make_range(size_t first, size_t last) {
+  return Range{Gannets::index_type{first}, Gannets::index_type{last}};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(WorkStealingPoolTests, EveryIndexIsVisitedExactlyOnce) {
+  for (auto thread_count : {0, 1, 3, 8}) {
+    auto pool   = typed::detail::work_stealing_pool{static_cast< size_t >(thread_count)};
+    auto visits = std::vector< std::atomic< int > >(10'000);
+
+    pool.run(make_range(0, visits.size()), 7, [&](size_t slot, const Range& chunk) {
+      ASSERT_LT(slot, pool.concurrency());
+      ASSERT_LE(chunk.size(), 7);
+      for (auto idx : chunk) {
+        ++visits[idx.get()];
+      }
+    });
+
+    ASSERT_TRUE(std::all_of(visits.begin(), visits.end(), [](auto&& v) { return 1 == v; })) << thread_count;
+  }
+}
+
+TEST(WorkStealingPoolTests, UnevenWorkIsShared) {
+  auto pool         = typed::detail::work_stealing_pool{3};
+  auto workers      = std::vector< std::atomic< size_t > >(pool.concurrency());
+  auto slow_workers = std::vector< std::atomic< size_t > >(pool.concurrency());
+
+  // All the slow items are at the start of the range, where the first thread starts.
+  pool.run(make_range(0, 256), 1, [&](size_t slot, const Range& chunk) {
+    if (chunk.front().get() < 64) {
+      std::this_thread::sleep_for(std::chrono::microseconds{200});
+      ++slow_workers[slot];
+    }
+    ++workers[slot];
+  });
+
+  ASSERT_EQ(256, std::accumulate(workers.begin(), workers.end(), size_t{0}));
+  ASSERT_EQ(64, std::accumulate(slow_workers.begin(), slow_workers.end(), size_t{0}));
+
+  // The other threads stole some of the slow items, rather than leaving them all to the first.
+  ASSERT_GE(std::count_if(slow_workers.begin(), slow_workers.end(), [](auto&& n) { return 0 != n; }), 2);
+  ASSERT_LT(slow_workers[0], 64);
+}
+
+TEST(WorkStealingPoolTests, ExceptionsAreRethrown) {
+  auto pool = typed::detail::work_stealing_pool{3};
+  ASSERT_THROW(pool.run(make_range(0, 1'000),
+                        1,
+                        [](size_t, const Range& chunk) {
+                          if (500 == chunk.front().get()) {
+                            throw std::runtime_error{"bad gannet"};
+                          }
+                        }),
+               std::runtime_error);
+
+  // The pool still works afterwards.
+  auto count = std::atomic< size_t >{0};
+  pool.run(make_range(0, 100), 1, [&](size_t, const Range& chunk) { count += chunk.size(); });
+  ASSERT_EQ(100, count);
+}
+
+TEST(WorkStealingPoolTests, JobsCanBeNested) {
+  auto pool  = typed::detail::work_stealing_pool{3};
+  auto count = std::atomic< size_t >{0};
+
+  pool.run(make_range(0, 16), 1, [&](size_t, const Range&) {
+    pool.run(make_range(0, 100), 4, [&](size_t, const Range& chunk) { count += chunk.size(); });
+  });
+
+  ASSERT_EQ(1'600, count);
+}
+
+TEST(WorkStealingPoolTests, ThreadsWithNothingToStealHelpWithNestedJobs) {
+  auto pool = typed::detail::work_stealing_pool{3};
+
+  auto mutex   = std::mutex{};
+  auto helpers = std::set< std::thread::id >{};
+
+  // Only the first outer item has work to do, in a nested job, which it starts after giving the other threads time to
+  // run out of outer items to steal. So they have to leave the outer job to help with it.
+  pool.run(make_range(0, 16), 1, [&](size_t, const Range& outer) {
+    if (0 == outer.front().get()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      pool.run(make_range(0, 64), 1, [&](size_t, const Range&) {
+        std::this_thread::sleep_for(std::chrono::microseconds{200});
+        auto lock = std::lock_guard{mutex};
+        helpers.insert(std::this_thread::get_id());
+      });
+    }
+  });
+
+  ASSERT_GE(helpers.size(), 2);
+}
+
+TEST(ParallelTests, ParallelForOverARange) {
+  auto gannets = make_gannets(50'000);
+
+  typed::parallel_for(typed::indices(gannets), [&](Gannets::index_type idx) { gannets.at(idx).dives = idx.get() * 2; });
+
+  for (auto i = Gannets::index_type{0}; i < gannets.size(); ++i) {
+    ASSERT_EQ(i.get() * 2, gannets.at(i).dives);
+  }
+}
+
+TEST(ParallelTests, ParallelForOverACollection) {
+  auto gannets = make_gannets(50'000);
+
+  typed::parallel_for(gannets, [](Gannet& gannet) { gannet.dives = gannet.id().get() + 1; });
+
+  for (auto i = Gannets::index_type{0}; i < gannets.size(); ++i) {
+    ASSERT_EQ(gannets.at(i).id().get() + 1, gannets.at(i).dives);
+  }
+}
+
+TEST(ParallelTests, GrainSizesBiggerThanTheIndexTypeAreFine) {
+  auto gannets = typed::identifiable_item_collection< Gannet, uint8_t >{};
+  for (auto i = size_t{0}; i < 100; ++i) {
+    gannets.add(Gannet{i});
+  }
+
+  auto visits = std::vector< std::atomic< int > >(gannets.size().get());
+  typed::parallel_for(typed::indices(gannets), [&](auto idx) { ++visits[idx.get()]; }, 256);
+  typed::parallel_for(typed::indices(gannets), [&](auto idx) { ++visits[idx.get()]; }, 1'000'000);
+
+  ASSERT_TRUE(std::all_of(visits.begin(), visits.end(), [](auto&& v) { return 2 == v; }));
+}
+
+TEST(ParallelTests, ParallelReduceOverACollection) {
+  const auto gannets = make_gannets(100'000);
+
+  const auto total = typed::parallel_reduce(
+      gannets, size_t{0}, [](const Gannet& gannet) { return gannet.id().get(); }, std::plus<>{});
+
+  ASSERT_EQ(size_t{99'999} * 100'000 / 2, total);
+}
+
+TEST(ParallelTests, ParallelReduceOverARange) {
+  const auto max = typed::parallel_reduce(
+      make_range(10, 1'000), size_t{0}, [](Gannets::index_type idx) { return idx.get(); }, [](size_t l, size_t r) {
+        return std::max(l, r);
+      });
+
+  ASSERT_EQ(999, max);
+}
+
+TEST(ParallelTests, LoopsCanRunOnAPoolOfTheirOwn) {
+  auto pool    = typed::parallel_pool{2};
+  auto gannets = make_gannets(10'000);
+
+  typed::parallel_for(pool, gannets, [](Gannet& gannet) { gannet.dives = gannet.id().get() % 3; });
+  typed::parallel_for(pool, typed::indices(gannets), [&](Gannets::index_type idx) { ++gannets.at(idx).dives; });
+
+  const auto total = typed::parallel_reduce(
+      pool, gannets, size_t{0}, [](const Gannet& gannet) { return gannet.dives; }, std::plus<>{});
+  const auto max = typed::parallel_reduce(
+      pool, typed::indices(gannets), size_t{0}, [](Gannets::index_type idx) { return idx.get(); }, [](size_t l, size_t r) {
+        return std::max(l, r);
+      });
+
+  ASSERT_EQ(3, pool.concurrency());
+  ASSERT_EQ(10'000 + 3'333 * (0 + 1 + 2), total);
+  ASSERT_EQ(9'999, max);
+}
+
+TEST(ParallelTests, ParallelReduceOfAnEmptyRangeIsTheIdentity) {
+  ASSERT_EQ(42, typed::parallel_reduce(make_range(0, 0), 42, [](auto) { return 1; }, std::plus<>{}));
+}
+
+template < typename Collection_T, typename Index_T >
+concept can_index_with = requires(Collection_T& collection, const Index_T& idx) { collection.at(idx); };
+
+template < typename Collection_T, typename Fn_T >
+concept can_parallel_for = requires(Collection_T& collection, Fn_T fn) { typed::parallel_for(collection, fn); };
+
+TEST(ParallelTests, RangesOnlyWorkWithTheirOwnCollection) {
+  using gannet_index = Range::index_type;
+
+  // A range of gannet indices can't be used on another kind of collection, even one of gannets with a different
+  // index type.
+  static_assert(can_index_with< Gannets, gannet_index >);
+  static_assert(not can_index_with< Puffins, gannet_index >);
+  static_assert(not can_index_with< typed::identifiable_item_collection< Gannet, uint8_t >, gannet_index >);
+
+  // Nor can a function of gannets be run over puffins.
+  static_assert(can_parallel_for< Gannets, void (*)(Gannet&) >);
+  static_assert(not can_parallel_for< Puffins, void (*)(Gannet&) >);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,213 @@
+#include <typed/collection_builder.hpp>
+#include <typed/identifiable.hpp>
+#include <typed/identifiable_item_collection.hpp>
+#include <typed/ordering.hpp>
+#include <typed/secondary_index.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Facility;
+using FacilityId = typed::id< Facility, uint16_t >;
+
+struct Heron : public typed::identifiable< Heron, size_t > {
+  Heron(size_t id, FacilityId facility, std::string name, int ring)
+      : typed::identifiable< Heron, size_t >{id}
+      , facility{facility}
+      , name{std::move(name)}
+      , ring{ring} {}
+
+  [[nodiscard]] const std::string& get_name() const noexcept { return name; }
+
+  FacilityId facility;
+  std::string name;
+  int ring;
+  int sightings{0};  // Not indexed, so it can be changed in place.
+};
+
+struct by_facility {};
+struct by_name {};
+struct by_ring {};
+struct by_site {};
+
+using Herons = typed::identifiable_item_collection< Heron,
+                                                    size_t,
+                                                    typed::hashed_non_unique< by_facility, &Heron::facility >,
+                                                    typed::ordered_unique< by_name, &Heron::get_name >,
+                                                    typed::hashed_unique< by_ring, &Heron::ring >,
+                                                    typed::ordered_non_unique< by_site, &Heron::facility > >;
+
+template < typename Range_T >
+std::vector< size_t > ids_of(Range_T&& items) {
+  auto out = std::vector< size_t >{};
+  for (auto&& item : items) {
+    out.push_back(item.id().get());
+  }
+
+  return out;
+}
+
+class SecondaryIndexTests : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    herons.add(Heron{1, FacilityId{10}, "grey", 101});
+    herons.add(Heron{2, FacilityId{20}, "great blue", 102});
+    herons.add(Heron{3, FacilityId{10}, "green", 103});
+    herons.add(Heron{4, FacilityId{30}, "goliath", 104});
+    herons.add(Heron{5, FacilityId{10}, "night", 105});
+  }
+
+  Herons herons;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_F(SecondaryIndexTests, IndexesCoverEveryItem) {
+  ASSERT_EQ(5, herons.by< by_facility >().size());
+  ASSERT_EQ(5, herons.by< by_name >().size());
+  ASSERT_EQ(5, herons.by< by_ring >().size());
+  ASSERT_EQ(5, herons.by< by_site >().size());
+}
+
+TEST_F(SecondaryIndexTests, FindByUniqueHashedKey) {
+  const auto heron = herons.by< by_ring >().find(103);
+  ASSERT_NE(nullptr, heron);
+  ASSERT_EQ(Heron::id_type{3}, heron->id());
+
+  ASSERT_EQ(nullptr, herons.by< by_ring >().find(999));
+}
+
+TEST_F(SecondaryIndexTests, FindByUniqueOrderedKey) {
+  const auto heron = herons.by< by_name >().find("goliath");
+  ASSERT_NE(nullptr, heron);
+  ASSERT_EQ(Heron::id_type{4}, heron->id());
+}
+
+TEST_F(SecondaryIndexTests, EqualRangeOfNonUniqueHashedKey) {
+  auto ids = ids_of(herons.by< by_facility >().equal_range(FacilityId{10}));
+  std::sort(ids.begin(), ids.end());
+
+  ASSERT_EQ((std::vector< size_t >{1, 3, 5}), ids);
+  ASSERT_EQ(3, herons.by< by_facility >().count(FacilityId{10}));
+  ASSERT_EQ(0, herons.by< by_facility >().count(FacilityId{40}));
+}
+
+TEST_F(SecondaryIndexTests, EqualRangeOfNonUniqueOrderedKeyIsInCollectionOrder) {
+  ASSERT_EQ((std::vector< size_t >{1, 3, 5}), ids_of(herons.by< by_site >().equal_range(FacilityId{10})));
+}
+
+TEST_F(SecondaryIndexTests, RangeOfOrderedKeys) {
+  ASSERT_EQ((std::vector< size_t >{1, 3, 5, 2}), ids_of(herons.by< by_site >().range(FacilityId{10}, FacilityId{30})));
+}
+
+TEST_F(SecondaryIndexTests, StartingWithPrefix) {
+  ASSERT_EQ((std::vector< size_t >{4, 2, 3, 1}), ids_of(herons.by< by_name >().starting_with("g")));
+  ASSERT_EQ((std::vector< size_t >{2, 3, 1}), ids_of(herons.by< by_name >().starting_with(std::string{"gr"})));
+  ASSERT_TRUE(ids_of(herons.by< by_name >().starting_with("x")).empty());
+}
+
+TEST_F(SecondaryIndexTests, ItemsFoundThroughANonConstIndexCanBeChanged) {
+  for (auto&& heron : herons.by< by_facility >().equal_range(FacilityId{10})) {
+    heron.sightings += 3;
+  }
+
+  herons.by< by_name >().find("goliath")->sightings = 7;
+
+  const auto& const_herons = herons;
+  ASSERT_EQ(3, const_herons.by< by_ring >().find(101)->sightings);
+  ASSERT_EQ(0, const_herons.by< by_ring >().find(102)->sightings);
+  ASSERT_EQ(3, const_herons.by< by_ring >().find(103)->sightings);
+  ASSERT_EQ(7, const_herons.find(Heron::id_type{4})->sightings);
+  ASSERT_EQ(3, const_herons.by< by_name >().find("night")->sightings);
+}
+
+TEST_F(SecondaryIndexTests, AddingADuplicateUniqueKeyFails) {
+  const auto [existing, added] = herons.add(Heron{6, FacilityId{10}, "grey", 106});
+
+  ASSERT_FALSE(added);
+  ASSERT_EQ(Heron::id_type{1}, existing->id());
+  ASSERT_EQ(Herons::size_type{5}, herons.size());
+  ASSERT_EQ(nullptr, herons.find(Heron::id_type{6}));
+  ASSERT_EQ(nullptr, herons.by< by_ring >().find(106));
+  ASSERT_EQ(3, herons.by< by_facility >().count(FacilityId{10}));
+}
+
+TEST_F(SecondaryIndexTests, AddingADuplicateIdFailsWithoutTouchingTheIndexes) {
+  const auto [existing, added] = herons.add(Heron{2, FacilityId{40}, "tiger", 107});
+
+  ASSERT_FALSE(added);
+  ASSERT_EQ(Heron::id_type{2}, existing->id());
+  ASSERT_FALSE(herons.by< by_name >().contains("tiger"));
+  ASSERT_EQ(5, herons.by< by_site >().size());
+}
+
+TEST_F(SecondaryIndexTests, RemoveTakesItemsOutOfTheIndexes) {
+  herons.remove(Heron::id_type{3});
+
+  ASSERT_EQ(nullptr, herons.by< by_name >().find("green"));
+  ASSERT_EQ(nullptr, herons.by< by_ring >().find(103));
+  ASSERT_EQ((std::vector< size_t >{1, 5}), ids_of(herons.by< by_site >().equal_range(FacilityId{10})));
+
+  // The key is free to use again.
+  ASSERT_TRUE(herons.add(Heron{6, FacilityId{20}, "green", 103}).second);
+  ASSERT_EQ(Heron::id_type{6}, herons.by< by_name >().find("green")->id());
+}
+
+TEST_F(SecondaryIndexTests, IndexesSurviveSortingById) {
+  herons.remove(Heron::id_type{1});
+  herons.add(Heron{1, FacilityId{10}, "grey", 101});
+
+  typed::sort_by_id(herons);
+
+  ASSERT_EQ(5, herons.by< by_ring >().size());
+  ASSERT_EQ((std::vector< size_t >{1, 3, 5}), ids_of(herons.by< by_site >().equal_range(FacilityId{10})));
+}
+
+TEST_F(SecondaryIndexTests, IndexesSurviveMovingTheCollection) {
+  auto moved = std::move(herons);
+
+  ASSERT_EQ(Heron::id_type{4}, moved.by< by_name >().find("goliath")->id());
+  ASSERT_EQ(moved.find(Heron::id_type{4}), moved.by< by_name >().find("goliath"));
+}
+
+TEST(SecondaryIndexBuilderTests, BuildDropsLaterItemsWithDuplicateUniqueKeys) {
+  auto builder = typed::collection_builder< Herons >{2};
+  builder.partial(0).add(Heron{1, FacilityId{10}, "grey", 101});
+  builder.partial(0).add(Heron{2, FacilityId{10}, "green", 102});
+  builder.partial(1).add(Heron{3, FacilityId{10}, "grey", 103});
+  builder.partial(1).add(Heron{4, FacilityId{20}, "night", 104});
+
+  const auto herons = builder.build(2);
+
+  ASSERT_EQ(Herons::size_type{3}, herons.size());
+  ASSERT_EQ(nullptr, herons.find(Heron::id_type{3}));
+  ASSERT_EQ(Heron::id_type{1}, herons.by< by_name >().find("grey")->id());
+  ASSERT_EQ(3, herons.by< by_facility >().size());
+}
+
+template < typename Index_T, typename Key_T >
+concept can_find_with = requires(const Index_T& index, const Key_T& key) { index.find(key); };
+
+TEST(SecondaryIndexTypeTests, LookupsNeedTheRightKeyType) {
+  using facility_index = std::remove_cvref_t< decltype(std::declval< Herons& >().by< by_facility >()) >;
+  static_assert(std::is_same_v< FacilityId, typename facility_index::key_type >);
+
+  // The facility index is keyed on a typed ID, so a plain number, or the ID of something else, won't do.
+  static_assert(can_find_with< facility_index, FacilityId >);
+  static_assert(not can_find_with< facility_index, uint16_t >);
+  static_assert(not can_find_with< facility_index, int >);
+  static_assert(not can_find_with< facility_index, Heron::id_type >);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////